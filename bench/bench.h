@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @brief Small timing helpers shared by the benchmarks. There is no framework:
+ *        each benchmark is a main() that times a few calls and prints one line
+ *        per measurement.
+ */
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Calls fn in doubling batches for at least min_seconds; returns the mean ns per call. */
+template <typename Function>
+double nanosecondsPerCall(Function fn, double min_seconds = 0.25) {
+    fn(); // Warm up caches and any lazy allocation
+    long long calls = 0;
+    long long batch = 1;
+    double elapsed = 0.0;
+    Clock::time_point start = Clock::now();
+    do {
+        for (long long i = 0; i < batch; ++i)
+            fn();
+        calls += batch;
+        batch *= 2;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < min_seconds);
+    return elapsed * 1e9 / calls;
+}
+
+/** @brief Keeps a result observable so the work producing it is not optimised away. */
+inline void keep(float value) {
+    static volatile float sink;
+    sink = value;
+}
+
+/** @brief Prints "name  time" with the time in the most readable unit. */
+inline void report(const char* name, double nanoseconds) {
+    if (nanoseconds < 1e3)
+        std::printf("%-52s %10.1f ns\n", name, nanoseconds);
+    else if (nanoseconds < 1e6)
+        std::printf("%-52s %10.2f us\n", name, nanoseconds / 1e3);
+    else
+        std::printf("%-52s %10.2f ms\n", name, nanoseconds / 1e6);
+}
+
+} // namespace bench
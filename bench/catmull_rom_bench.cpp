@@ -0,0 +1,95 @@
+// Catmull-Rom sampling: the precomputed-coefficient evaluator in catmull_rom.h against
+// the per-sample evaluation the spline animations used before it.
+
+#include "bench.h"
+#include "catmull_rom.h"
+#include <cmath>
+#include <vector>
+#include <algorithm> // For std::max
+
+namespace {
+
+constexpr int kNumSpans = 10;         // SplineDeformation's loop
+constexpr int kSamplesPerSpan = 50;   // The button animations' fixed count
+constexpr float kTolerance = 0.25f;   // Default adaptive tolerance, in pixels
+
+// The previous path: knots, tangents and coefficients recomputed for every sample.
+visage::Point legacySplineInterpolation(visage::Point p0, visage::Point p1, visage::Point p2, visage::Point p3,
+                                        float t, float tension = 0.0f, float alpha = 0.5f) {
+    auto distance = [](visage::Point a, visage::Point b) { return std::sqrt(std::pow(a.x - b.x, 2) + std::pow(a.y - b.y, 2)); };
+
+    float t01 = std::pow(distance(p0, p1), alpha);
+    float t12 = std::pow(distance(p1, p2), alpha);
+    float t23 = std::pow(distance(p2, p3), alpha);
+    if (t01 < 1e-6f) t01 = 1.0f;
+    if (t12 < 1e-6f) t12 = 1.0f;
+    if (t23 < 1e-6f) t23 = 1.0f;
+
+    float inv_t01 = 1.0f / t01;
+    float inv_t23 = 1.0f / t23;
+    float inv_t01_t12 = 1.0f / (t01 + t12);
+    float inv_t12_t23 = 1.0f / (t12 + t23);
+
+    visage::Point m1 = (p2 - p1 + (p1 - p0) * inv_t01 * t12 - (p2 - p0) * inv_t01_t12 * t12) * (1.0f - tension);
+    visage::Point m2 = (p2 - p1 + (p3 - p2) * inv_t23 * t12 - (p3 - p1) * inv_t12_t23 * t12) * (1.0f - tension);
+
+    visage::Point a = (p1 - p2) * 2.0f + m1 + m2;
+    visage::Point b = (p1 - p2) * -3.0f - m1 - m1 - m2;
+    return a * (t * t * t) + b * (t * t) + m1 * t + p1;
+}
+
+void sampleLegacy(const visage::Point* control_points, visage::Point* out) {
+    for (int i = 0; i < kNumSpans; ++i) {
+        for (int j = 0; j < kSamplesPerSpan; ++j) {
+            float t = static_cast<float>(j) / kSamplesPerSpan;
+            out[i * kSamplesPerSpan + j] = legacySplineInterpolation(control_points[i], control_points[i + 1],
+                                                                     control_points[i + 2], control_points[i + 3], t);
+        }
+    }
+}
+
+// A deformed circle like the animations draw, with the first three points repeated at the end.
+std::vector<visage::Point> controlPoints() {
+    std::vector<visage::Point> points;
+    for (int i = 0; i < kNumSpans + 3; ++i) {
+        float angle = 6.2831853f * (i % kNumSpans) / kNumSpans;
+        float radius = 200.0f + 40.0f * std::sin(3.0f * angle);
+        points.emplace_back(400.0f + radius * std::cos(angle), 300.0f + radius * std::sin(angle));
+    }
+    return points;
+}
+
+} // namespace
+
+int main() {
+    std::vector<visage::Point> control_points = controlPoints();
+    std::vector<visage::Point> legacy(kNumSpans * kSamplesPerSpan);
+    std::vector<visage::Point> fixed(kNumSpans * kSamplesPerSpan);
+    std::vector<visage::Point> adaptive;
+
+    sampleLegacy(control_points.data(), legacy.data());
+    sampleClosedCatmullRom(control_points.data(), kNumSpans, kSamplesPerSpan, fixed.data());
+    float max_error = 0.0f;
+    for (size_t i = 0; i < legacy.size(); ++i)
+        max_error = std::max(max_error, std::max(std::abs(legacy[i].x - fixed[i].x), std::abs(legacy[i].y - fixed[i].y)));
+    std::printf("%d spans x %d samples, largest difference from the old path: %g px\n", kNumSpans, kSamplesPerSpan,
+                max_error);
+
+    bench::report("old per-sample evaluation, one loop", bench::nanosecondsPerCall([&] {
+        sampleLegacy(control_points.data(), legacy.data());
+        bench::keep(legacy.back().x);
+    }));
+    bench::report("sampleClosedCatmullRom, one loop", bench::nanosecondsPerCall([&] {
+        sampleClosedCatmullRom(control_points.data(), kNumSpans, kSamplesPerSpan, fixed.data());
+        bench::keep(fixed.back().x);
+    }));
+
+    int num_adaptive = sampleClosedCatmullRomAdaptive(control_points.data(), kNumSpans, kTolerance, kSamplesPerSpan, adaptive);
+    double adaptive_ns = bench::nanosecondsPerCall([&] {
+        sampleClosedCatmullRomAdaptive(control_points.data(), kNumSpans, kTolerance, kSamplesPerSpan, adaptive);
+        bench::keep(adaptive.back().x);
+    });
+    bench::report("sampleClosedCatmullRomAdaptive (0.25 px), one loop", adaptive_ns);
+    std::printf("adaptive sampling emitted %d of %d samples\n", num_adaptive, kNumSpans * kSamplesPerSpan);
+    return 0;
+}
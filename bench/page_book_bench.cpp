@@ -0,0 +1,86 @@
+// Page book loading: load() of a large book, which only validates the offset table, and
+// decoding every page, as the view manager does one slide at a time.
+
+#include "bench.h"
+#include "page_data.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kNumPages = 1000;
+
+void writeU16(std::vector<uint8_t>& out, size_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void writeU32(std::vector<uint8_t>& out, size_t position, size_t value) {
+    for (int i = 0; i < 4; ++i)
+        out[position + i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+// The same layout tools/pack_pages.py writes.
+std::vector<uint8_t> packBook(const std::vector<PageData>& pages) {
+    std::vector<uint8_t> out(PageBook::kMagic, PageBook::kMagic + sizeof(PageBook::kMagic));
+    writeU16(out, PageBook::kVersion);
+    writeU16(out, pages.size());
+    size_t table = out.size();
+    out.resize(table + 4 * (pages.size() + 1));
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        writeU32(out, table + 4 * i, out.size());
+        out.push_back(static_cast<uint8_t>(pages[i].animation));
+        out.push_back(static_cast<uint8_t>(pages[i].runs.size()));
+        for (const PageRun& run : pages[i].runs) {
+            writeU16(out, static_cast<size_t>(run.size * PageBook::kUnitsPerHeight + 0.5f));
+            writeU16(out, static_cast<size_t>(run.y * PageBook::kUnitsPerHeight + 0.5f));
+            writeU16(out, run.text.size());
+            out.insert(out.end(), run.text.begin(), run.text.end());
+        }
+    }
+    writeU32(out, table + 4 * pages.size(), out.size());
+    return out;
+}
+
+std::vector<PageData> makePages() {
+    std::vector<PageData> pages(kNumPages);
+    for (int i = 0; i < kNumPages; ++i) {
+        pages[i].animation = static_cast<PageAnimation>(i % static_cast<int>(PageAnimation::kCount));
+        pages[i].runs = {
+            { "Slide " + std::to_string(i + 1), 0.05f, 0.1f },
+            { "What you are seeing is a Hardware Accelerated Website In C++.", 0.03f, 0.2f },
+            { "Programmed directly from your GPU to your screen.", 0.025f, 0.3f },
+            { "Page " + std::to_string(i + 1) + " / " + std::to_string(kNumPages), 0.025f, 0.7f },
+        };
+    }
+    return pages;
+}
+
+} // namespace
+
+int main() {
+    std::vector<uint8_t> bytes = packBook(makePages());
+    PageBook book;
+    if (!book.load(bytes.data(), bytes.size()) || book.numPages() != kNumPages) {
+        std::printf("The packed book did not load.\n");
+        return 1;
+    }
+    std::printf("%d pages, %zu bytes\n", kNumPages, bytes.size());
+
+    bench::report("PageBook::load", bench::nanosecondsPerCall([&] {
+        book.load(bytes.data(), bytes.size());
+        bench::keep(static_cast<float>(book.numPages()));
+    }));
+
+    PageData page;
+    int failed = 0;
+    double decode_ns = bench::nanosecondsPerCall([&] {
+        for (int i = 0; i < book.numPages(); ++i)
+            failed += !book.decode(i, page);
+        bench::keep(page.runs.back().y);
+    });
+    bench::report("decode every page", decode_ns);
+    bench::report("decode, per page", decode_ns / kNumPages);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+// Particle update cost per particle at the pulsar's pool capacity: the fixed-capacity pool's
+// age + removeDead + integrate + refill, the vector-of-structs loop it replaced (erase() for
+// every dead particle, push_back() to refill), and a whole CosmicPulsarAnimation step.
+
+#include "bench.h"
+#include "animated_frame.h"
+#include "particles.h"
+#include "random.h"
+#include <vector>
+
+namespace {
+
+constexpr float kDt = 1.0f / 60.0f;
+constexpr float kLifetime = CosmicPulsarAnimation::kParticleLifetime;
+
+// Launch values drawn once and cycled through, so refills cost the pool's work, not the RNG's.
+struct Launches {
+    static constexpr int kCount = 4096;
+    std::vector<float> vx, vy, lifetime;
+    int next = 0;
+
+    Launches() : vx(kCount), vy(kCount), lifetime(kCount) {
+        FastRandom random(2);
+        random.fillUniform(vx.data(), kCount, -96.0f, 96.0f);
+        random.fillUniform(vy.data(), kCount, -96.0f, 96.0f);
+        random.fillUniform(lifetime.data(), kCount, kLifetime * 0.7f, kLifetime * 1.3f);
+    }
+
+    int take() {
+        next = (next + 1) % kCount;
+        return next;
+    }
+};
+
+// The particle CosmicPulsarAnimation used to keep in a std::vector.
+struct LegacyParticle {
+    visage::Point position;
+    visage::Point velocity;
+    float lifetime;
+    float initial_lifetime;
+    visage::Color color;
+};
+
+// Pools start with remaining lives spread over a lifetime, so each step retires and
+// refills about dt / lifetime of them, as a running effect does.
+void fillPool(ParticleArrays& particles, int count, Launches& launches) {
+    FastRandom random(1);
+    std::vector<float> ages(count);
+    random.fillUniform(ages.data(), count, 0.0f, 1.0f);
+    particles.setCapacity(count);
+    for (int i = 0; i < count; ++i) {
+        int l = launches.take();
+        particles.add(400.0f, 300.0f, launches.vx[l], launches.vy[l], launches.lifetime[l]);
+        particles.life()[i] *= ages[i];
+    }
+}
+
+void fillLegacy(std::vector<LegacyParticle>& particles, int count, Launches& launches) {
+    FastRandom random(1);
+    std::vector<float> ages(count);
+    random.fillUniform(ages.data(), count, 0.0f, 1.0f);
+    particles.clear();
+    for (int i = 0; i < count; ++i) {
+        int l = launches.take();
+        particles.push_back({ visage::Point(400.0f, 300.0f), visage::Point(launches.vx[l], launches.vy[l]),
+                              launches.lifetime[l] * ages[i], launches.lifetime[l], 0xff76b900 });
+    }
+}
+
+void stepPool(ParticleArrays& particles, Launches& launches) {
+    particles.age(kDt);
+    particles.removeDead();
+    particles.integrate(kDt);
+    while (!particles.full()) {
+        int l = launches.take();
+        particles.add(400.0f, 300.0f, launches.vx[l], launches.vy[l], launches.lifetime[l]);
+    }
+}
+
+void stepLegacy(std::vector<LegacyParticle>& particles, int count, Launches& launches) {
+    for (auto it = particles.begin(); it != particles.end();) {
+        it->lifetime -= kDt;
+        if (it->lifetime <= 0) {
+            it = particles.erase(it);
+            continue;
+        }
+        it->position += it->velocity * kDt;
+        ++it;
+    }
+    while (static_cast<int>(particles.size()) < count) {
+        int l = launches.take();
+        particles.push_back({ visage::Point(400.0f, 300.0f), visage::Point(launches.vx[l], launches.vy[l]),
+                              launches.lifetime[l], launches.lifetime[l], 0xff76b900 });
+    }
+}
+
+void reportPerParticle(const char* label, int count, double step_ns) {
+    char name[96];
+    std::snprintf(name, sizeof(name), "%s, %d particles, per step", label, count);
+    bench::report(name, step_ns);
+    std::snprintf(name, sizeof(name), "%s, %d particles, per particle", label, count);
+    bench::report(name, step_ns / count);
+}
+
+} // namespace
+
+int main() {
+    std::printf("Particle update at dt = 1/60 s, about %.1f%% of particles retired and refilled per step\n",
+                100.0f * kDt / kLifetime);
+    std::printf("pool: age + removeDead + integrate + refill; old vector: erase + push_back\n");
+
+    for (int count : { 10000, CosmicPulsarAnimation::kMaxParticles }) {
+        Launches launches;
+        ParticleArrays pool;
+        fillPool(pool, count, launches);
+        reportPerParticle("pool", count, bench::nanosecondsPerCall([&] {
+            stepPool(pool, launches);
+            bench::keep(pool.x()[0]);
+        }));
+
+        std::vector<LegacyParticle> legacy;
+        fillLegacy(legacy, count, launches);
+        reportPerParticle("old vector", count, bench::nanosecondsPerCall([&] {
+            stepLegacy(legacy, count, launches);
+            bench::keep(legacy[0].position.x);
+        }));
+    }
+
+    // The whole simulation step as the animation runs it, with emission and life ratios,
+    // once the budget has filled and emission balances expiry.
+    CosmicPulsarAnimation::Simulation simulation;
+    simulation.setSeed(1);
+    simulation.setCenter(visage::Point(400.0f, 300.0f));
+    simulation.setParticleBudget(CosmicPulsarAnimation::kMaxParticles);
+    for (int i = 0; i < 4 * 60; ++i)
+        simulation.step(kDt);
+    int live = simulation.particles().size();
+    reportPerParticle("Simulation::step", live, bench::nanosecondsPerCall([&] {
+        simulation.step(kDt);
+        bench::keep(simulation.lifeRatios()[0]);
+    }));
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Node web connections: SpatialGrid's neighbour query against testing every pair, and the
+// per-frame cost of the web at the node counts setNumPoints() allows.
+
+#include "bench.h"
+#include "NeuralNetVisage.h"
+#include "random.h"
+#include "spatial_grid.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float kRadius = SimplifiedWebFrame::kConnectionDist;
+constexpr float kAreaPerNode = 800.0f * 600.0f / SimplifiedWebFrame::kNumPoints; // The default look's density
+constexpr int kMaxBruteForce = 20000; // Past this one all-pairs pass takes seconds
+
+struct Nodes {
+    std::vector<float> x, y;
+    float width = 0.0f;
+    float height = 0.0f;
+};
+
+// count nodes spread uniformly over a 4:3 area sized to keep the default density.
+Nodes makeNodes(int count) {
+    Nodes nodes;
+    nodes.width = std::sqrt(count * kAreaPerNode * 4.0f / 3.0f);
+    nodes.height = nodes.width * 0.75f;
+    nodes.x.resize(count);
+    nodes.y.resize(count);
+    FastRandom random(1);
+    random.fillUniform(nodes.x.data(), count, 0.0f, nodes.width);
+    random.fillUniform(nodes.y.data(), count, 0.0f, nodes.height);
+    return nodes;
+}
+
+int bruteForcePairs(const Nodes& nodes) {
+    int pairs = 0;
+    int count = static_cast<int>(nodes.x.size());
+    for (int i = 0; i < count; ++i) {
+        for (int j = i + 1; j < count; ++j) {
+            float dx = nodes.x[i] - nodes.x[j];
+            float dy = nodes.y[i] - nodes.y[j];
+            pairs += dx * dx + dy * dy < kRadius * kRadius;
+        }
+    }
+    return pairs;
+}
+
+int gridPairs(SpatialGrid& grid, const Nodes& nodes) {
+    int count = static_cast<int>(nodes.x.size());
+    grid.build(count, nodes.width, nodes.height, kRadius,
+               [&](int i) { return visage::Point(nodes.x[i], nodes.y[i]); });
+    int pairs = 0;
+    grid.forEachPairWithin(kRadius, [&](int, int, float) { ++pairs; });
+    return pairs;
+}
+
+} // namespace
+
+int main() {
+    char name[96];
+    SpatialGrid grid;
+    std::printf("Connections at constant density (%d nodes per 800x600)\n", SimplifiedWebFrame::kNumPoints);
+    for (int count : { SimplifiedWebFrame::kNumPoints, 1000, 10000, SimplifiedWebFrame::kMaxPoints, 50000 }) {
+        Nodes nodes = makeNodes(count);
+        int pairs = gridPairs(grid, nodes);
+        std::snprintf(name, sizeof(name), "grid, %d nodes (%d pairs)", count, pairs);
+        bench::report(name, bench::nanosecondsPerCall([&] { bench::keep(static_cast<float>(gridPairs(grid, nodes))); }));
+
+        if (count > kMaxBruteForce) continue;
+        int brute_force_pairs = bruteForcePairs(nodes);
+        std::snprintf(name, sizeof(name), "all pairs, %d nodes%s", count, brute_force_pairs == pairs ? "" : " MISMATCH");
+        bench::report(name, bench::nanosecondsPerCall([&] { bench::keep(static_cast<float>(bruteForcePairs(nodes))); }));
+    }
+
+    // The web as drawn: one motion step plus the connection query, in a fixed 1920x1080
+    // frame, so raising the count also raises the density.
+    std::printf("\nSimplifiedWebFrame::Simulation at 1920x1080, step + connections\n");
+    for (int count : { SimplifiedWebFrame::kNumPoints, 1000, 10000, SimplifiedWebFrame::kMaxPoints }) {
+        SimplifiedWebFrame::Simulation simulation;
+        simulation.setSeed(1);
+        simulation.setBounds(1920.0f, 1080.0f);
+        simulation.setNumPoints(count);
+        simulation.initPoints();
+
+        const ParticleArrays& points = simulation.points();
+        int pairs = 0;
+        double ns = bench::nanosecondsPerCall([&] {
+            simulation.step(1.0f / 60.0f);
+            grid.build(points.size(), 1920.0f, 1080.0f, kRadius,
+                       [&](int i) { return visage::Point(points.x()[i], points.y()[i]); });
+            pairs = 0;
+            grid.forEachPairWithin(kRadius, [&](int, int, float) { ++pairs; });
+        });
+        std::snprintf(name, sizeof(name), "setNumPoints(%d), %d pairs", count, pairs);
+        bench::report(name, ns);
+    }
+    return 0;
+}
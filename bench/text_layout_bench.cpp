@@ -0,0 +1,73 @@
+// Slide text: drawing each run through a retained TextLayout against handing the canvas
+// the string on every draw, over a replay of page frames with one resize.
+
+#include "bench.h"
+#include "font_cache.h"
+#include "page_data.h"
+#include "text_layout.h"
+#include <vector>
+
+namespace {
+
+constexpr int kNumFrames = 600;
+constexpr int kResizeFrame = kNumFrames / 2;
+
+struct Size {
+    int width;
+    int height;
+};
+
+Size frameSize(int frame) { return frame < kResizeFrame ? Size{ 800, 600 } : Size{ 1280, 720 }; }
+
+// Draws a page's runs the way SlidePage does, either with the retained layouts or with strings.
+void drawPage(visage::Canvas& canvas, const PageData& page, std::vector<TextLayout>* layouts, Size size) {
+    for (size_t i = 0; i < page.runs.size(); ++i) {
+        const PageRun& run = page.runs[i];
+        int font_height = static_cast<int>(size.height * run.size);
+        const visage::Font& font = FontCache::shared().get(font_height);
+        if (layouts)
+            (*layouts)[i].draw(canvas, font, 0, size.height * run.y, size.width, font_height);
+        else
+            canvas.text(run.text, font, visage::Font::Justification::kCenter, 0, size.height * run.y, size.width,
+                        font_height);
+    }
+}
+
+} // namespace
+
+int main() {
+    PageData page = fallbackPage();
+    std::vector<TextLayout> layouts;
+    for (const PageRun& run : page.runs)
+        layouts.emplace_back(run.text);
+
+    // Fonts are created outside the timed loops so both paths start from a warm cache.
+    for (Size size : { frameSize(0), frameSize(kNumFrames - 1) }) {
+        for (const PageRun& run : page.runs)
+            FontCache::shared().get(static_cast<int>(size.height * run.size));
+    }
+
+    // Every draw is recorded into the canvas, so each path gets a fresh one for a fixed frame count.
+    visage::Canvas string_canvas;
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int frame = 0; frame < kNumFrames; ++frame)
+        drawPage(string_canvas, page, nullptr, frameSize(frame));
+    double string_ns = std::chrono::duration<double, std::nano>(bench::Clock::now() - start).count();
+
+    visage::Canvas layout_canvas;
+    start = bench::Clock::now();
+    for (int frame = 0; frame < kNumFrames; ++frame)
+        drawPage(layout_canvas, page, &layouts, frameSize(frame));
+    double layout_ns = std::chrono::duration<double, std::nano>(bench::Clock::now() - start).count();
+
+    int num_layouts = 0;
+    for (const TextLayout& layout : layouts)
+        num_layouts += layout.numLayouts();
+
+    std::printf("%d frames of %zu runs, resized at frame %d\n", kNumFrames, page.runs.size(), kResizeFrame);
+    bench::report("canvas.text(string), per frame", string_ns / kNumFrames);
+    bench::report("TextLayout::draw, per frame", layout_ns / kNumFrames);
+    std::printf("layouts: %d with TextLayout, %d with strings (one per draw)\n", num_layouts,
+                kNumFrames * static_cast<int>(page.runs.size()));
+    return 0;
+}
@@ -0,0 +1,55 @@
+// WorkerPool scaling: one particle step (integrate, bounce, age) over a large pool at each
+// thread count the pool allows on this machine.
+
+#include "bench.h"
+#include "particles.h"
+#include "random.h"
+#include "worker_pool.h"
+#include <vector>
+
+namespace {
+
+constexpr int kNumParticles = 1000000;
+constexpr float kWidth = 1920.0f;
+constexpr float kHeight = 1080.0f;
+
+void fill(ParticleArrays& particles) {
+    std::vector<float> x(kNumParticles), y(kNumParticles), vx(kNumParticles), vy(kNumParticles);
+    FastRandom random(1);
+    random.fillUniform(x.data(), kNumParticles, 0.0f, kWidth);
+    random.fillUniform(y.data(), kNumParticles, 0.0f, kHeight);
+    random.fillUniform(vx.data(), kNumParticles, -80.0f, 80.0f);
+    random.fillUniform(vy.data(), kNumParticles, -80.0f, 80.0f);
+    particles.setCapacity(kNumParticles);
+    for (int i = 0; i < kNumParticles; ++i)
+        particles.add(x[i], y[i], vx[i], vy[i], 1000.0f);
+}
+
+} // namespace
+
+int main() {
+    ParticleArrays particles;
+    fill(particles);
+
+    std::printf("%d particles, up to %d threads (%s)\n", kNumParticles, WorkerPool::defaultNumThreads(),
+                HIRE_ME_HAS_THREADS ? "threaded build" : "no thread support, everything runs inline");
+    char name[96];
+    double single_thread_ns = 0.0;
+    for (int num_threads = 1; num_threads <= WorkerPool::defaultNumThreads(); ++num_threads) {
+        WorkerPool pool(num_threads);
+        double ns = bench::nanosecondsPerCall([&] {
+            pool.parallelFor(particles.size(), [&](int begin, int end) {
+                particles.integrate(1.0f / 120.0f, begin, end);
+                particles.bounce(0.0f, 0.0f, kWidth, kHeight, begin, end);
+                particles.age(1.0f / 120.0f, begin, end);
+            });
+            bench::keep(particles.x()[0]);
+        });
+        if (num_threads == 1)
+            single_thread_ns = ns;
+        std::snprintf(name, sizeof(name), "step, %d thread%s (%.2fx)", pool.numThreads(), num_threads == 1 ? "" : "s",
+                      single_thread_ns / ns);
+        bench::report(name, ns);
+    }
+    return 0;
+}
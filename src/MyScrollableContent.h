@@ -3,6 +3,9 @@
 #include "visage/ui.h"
 #include "visage/graphics.h"
 #include "embedded/fonts.h"
+#include "layer_cache.h"
+#include "font_cache.h"
+#include "text_layout.h"
 #include <string>
 class MyScrollableContent : public visage::ScrollableFrame {
 public:
@@ -36,6 +39,7 @@ public:
             int index = i;
             // Add frame_color to the capture list. It will be copied by value.
             frame.onDraw() = [this, &frame, frame_color, index](visage::Canvas& canvas) {
+                layers_[index].noteRendered();
                 int height_ = frame.height(); // Call height()
                 int width_ = frame.width();   // Call width()
                 canvas.setColor(frame_color);
@@ -44,15 +48,18 @@ public:
                 int x_pad = 0;//width_ * 0.10f;               // Call width()
                 int y_pad = 0;//height_ * 0.10f;              // Call height()
                 canvas.roundedRectangle(x_pad, y_pad, actual_width, actual_height, 16);
-                visage::Font myFont(16, visage::fonts::Lato_Regular_ttf);
+                const visage::Font& myFont = FontCache::shared().get(16);
 
                 canvas.setColor(0xff000000);
                 //canvas.roundedRectangle(0, 0, frame.width(), frame.height(), 16);
 
                 // Corrected call to canvas.text()
                 // You need to provide the string, a font, a justification, and then the coordinates.
-                canvas.text(welcome, myFont, visage::Font::Justification::kCenter, x_pad, y_pad, actual_width, actual_height);
+                card_text_[index].draw(canvas, myFont, x_pad, y_pad, actual_width, actual_height);
             };
+            // Scrolling only moves the cards, so each one keeps its rendered texture.
+            layers_[i].attach(&frame);
+            card_text_[i].setText(welcome);
         }
         setScrollableHeight(1000.0f,0.0f);
         setYPosition(300.0f); // Set initial scroll position
@@ -80,7 +87,8 @@ public:
 private:
     bool m_content_created = false;
     Frame frames_[kNumFrames];
-    visage::Text text_;
+    CachedLayer layers_[kNumFrames];
 
     std::string welcome = "Built entirely with C++, this website utilizes a hardware-accelerated GPU to program straight to your browser.";
+    TextLayout card_text_[kNumFrames];
 };
\ No newline at end of file
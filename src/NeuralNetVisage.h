@@ -17,13 +17,15 @@
 #include <vector>
 #include <cmath>
 #include <algorithm> // For std::min/max
-#include <cstdlib>   // For rand() and srand()
-#include <ctime>     // For time() to seed srand()
-// NOTE: Please call srand(time(NULL)); once at the beginning of your main() function.
-inline float random_float(float min, float max) {
-    if (min >= max) return min;
-    return min + (static_cast<float>(rand()) / static_cast<float>(RAND_MAX)) * (max - min);
-}
+#include <ctime>     // For time() to seed the default generator
+#include "spatial_grid.h"
+#include "particles.h"
+#include "random.h"
+#include "worker_pool.h"
+#include "simulation_pipeline.h"
+#include "instance_batch.h"
+#include "boost.h" // For scaleBoosts
+#include "animation_scheduler.h"
 
 inline float point_distance(visage::Point p1, visage::Point p2) {
     float dx = p1.x - p2.x;
@@ -32,14 +34,6 @@ inline float point_distance(visage::Point p1, visage::Point p2) {
 }
 
 
-// A simple structure to hold our animated points
-struct Node {
-    visage::Point pos;
-    visage::Point vel;
-    float unique_offset;
-};
-
-
 /**
  * @class SimplifiedWebFrame
  * @brief A performant frame that draws an animated web of interconnected points.
@@ -47,23 +41,167 @@ struct Node {
 class SimplifiedWebFrame : public visage::Frame {
 public:
     // --- CONFIGURATION ---
-    static constexpr int kNumPoints = 70;
+    static constexpr int kNumPoints = 70;      // Default node count
+    static constexpr int kMaxPoints = 16384;   // Node capacity; setNumPoints() can raise the count this far
     static constexpr float kMaxSpeed = 25.0f;
     static constexpr float kConnectionDist = 150.0f;
+    static constexpr float kMaxConnectionAlpha = 100.0f / 255.0f; // Opacity of the shortest edges
+
+    // Node positions and pulse phases, as the renderer sees them after one step.
+    struct Snapshot {
+        std::vector<float> x, y, phase;
+    };
+
+    /**
+     * Node motion, independent of drawing so it can be stepped either from
+     * draw() or by a SimulationPipeline.
+     */
+    class Simulation {
+    public:
+        Simulation() : random_(static_cast<uint64_t>(time(nullptr))) {}
+
+        void setSeed(uint64_t seed) { random_.setSeed(seed); }
+        void setBounds(float width, float height) {
+            width_ = width;
+            height_ = height;
+        }
+
+        // Nodes use position, velocity and phase (their pulse offset); life is unused.
+        void initPoints() {
+            points_.setCapacity(kMaxPoints);
+            addPoints(num_points_);
+        }
+
+        // Spawns nodes up to num_points once initialised; never removes any.
+        void setNumPoints(int num_points) {
+            num_points_ = num_points;
+            if (!points_.empty())
+                addPoints(num_points_ - points_.size());
+        }
+
+        void step(float dt) {
+            float max_x = width_;
+            float max_y = height_;
+            WorkerPool::shared().parallelFor(points_.size(), [&](int begin, int end) {
+                points_.integrate(dt, begin, end);
+                points_.bounce(0.0f, 0.0f, max_x, max_y, begin, end);
+            });
+        }
+
+        void capture(Snapshot& snapshot) const {
+            int count = points_.size();
+            snapshot.x.assign(points_.x(), points_.x() + count);
+            snapshot.y.assign(points_.y(), points_.y() + count);
+            snapshot.phase.assign(points_.phase(), points_.phase() + count);
+        }
+
+        const ParticleArrays& points() const { return points_; }
+
+    private:
+        void addPoints(int count) {
+            if (count <= 0) return;
+            xs_.resize(count);
+            ys_.resize(count);
+            angles_.resize(count);
+            speeds_.resize(count);
+            offsets_.resize(count);
+            random_.fillUniform(xs_.data(), count, 0, width_);
+            random_.fillUniform(ys_.data(), count, 0, height_);
+            random_.fillAngles(angles_.data(), count);
+            random_.fillUniform(speeds_.data(), count, kMaxSpeed * 0.5f, kMaxSpeed);
+            random_.fillUniform(offsets_.data(), count, 0, 100.0f);
+
+            for (int i = 0; i < count; ++i) {
+                points_.add(xs_[i], ys_[i], cos(angles_[i]) * speeds_[i], sin(angles_[i]) * speeds_[i], 0.0f, offsets_[i]);
+            }
+        }
+
+        ParticleArrays points_;
+        FastRandom random_;
+        std::vector<float> xs_, ys_, angles_, speeds_, offsets_; // Spawn scratch
+        int num_points_ = kNumPoints;
+        float width_ = 0.0f;
+        float height_ = 0.0f;
+    };
 
     SimplifiedWebFrame() : last_time_(0.0) {
         setIgnoresMouseEvents(true, false);
+        batch_.setPalette(visage::Color(0xff76b900));
+
+        // While hidden the simulation thread is stopped and the next draw restarts the
+        // time base, so the hidden period is not simulated as one huge step.
+        animation_.setCallbacks(
+            [this] {
+                pipeline_.stop();
+                last_time_ = 0.0;
+            },
+            [this] {
+                if (pipelined_)
+                    pipeline_.start();
+            });
+    }
+
+    ~SimplifiedWebFrame() override { pipeline_.stop(); }
+
+    // Reseeds and rebuilds the nodes, so a given seed always gives the same layout and motion.
+    void setSeed(uint64_t seed) {
+        bool has_size = width() > 0 && height() > 0;
+        pipeline_.modify([&](Simulation& simulation) {
+            simulation.setSeed(seed);
+            if (has_size)
+                simulation.initPoints();
+        });
     }
 
     void resized() override {
-        if (points_.empty() && width() > 0 && height() > 0) {
-            initPoints();
-        }
+        float render_width = width();
+        float render_height = height();
+        pipeline_.modify([&](Simulation& simulation) {
+            simulation.setBounds(render_width, render_height);
+            if (simulation.points().empty() && render_width > 0 && render_height > 0) {
+                simulation.initPoints();
+            }
+        });
+    }
+
+    /**
+     * Moves node motion onto its own fixed-timestep thread; draw() then only
+     * interpolates between the last two steps. Off by default.
+     */
+    void setPipelined(bool pipelined) {
+        pipelined_ = pipelined;
+        if (pipelined)
+            pipeline_.start();
+        else
+            pipeline_.stop();
+        last_time_ = 0.0;
+    }
+
+    bool pipelined() const { return pipelined_; }
+
+    // Draws and connects the first num_points nodes, up to kMaxPoints. Nodes are spawned the
+    // first time the count goes past the ones already moving; lowering it only stops drawing
+    // the rest, so raising it again brings them back in place rather than respawning them.
+    void setNumPoints(int num_points) {
+        num_points_ = std::min(std::max(num_points, 0), kMaxPoints);
+        int spawn = num_points_;
+        pipeline_.modify([&](Simulation& simulation) {
+            if (spawn > simulation.points().size())
+                simulation.setNumPoints(spawn);
+        });
     }
+    int numPoints() const { return num_points_; }
+    PipelineStats pipelineStats() const { return pipeline_.stats(); }
+    void setShowPipelineStats(bool show) { show_pipeline_stats_ = show; }
 
     void draw(visage::Canvas& canvas) override {
-        if (points_.empty()) {
-            redraw();
+        if (pipeline_.running()) {
+            drawPipelined(canvas);
+            return;
+        }
+
+        const ParticleArrays& points = pipeline_.simulation().points();
+        if (points.empty()) {
             return;
         }
 
@@ -77,33 +215,28 @@ public:
         
         // --- Update and Draw ---
         updatePoints(dt);
-        drawConnections(canvas);
-        drawPoints(canvas);
-        
-        // THIS IS THE FIX: By placing redraw() here, the animating frame itself
-        // tells the application it needs to be rendered again. This creates a
-        // controlled animation loop tied to the browser's refresh rate.
-        redraw();
+        int count = std::min(points.size(), num_points_);
+        drawConnections(canvas, points.x(), points.y(), count);
+        drawPoints(canvas, points.x(), points.y(), points.phase(), count);
     }
 
 private:
-    std::vector<Node> points_;
+    SimulationPipeline<Simulation, Snapshot> pipeline_;
+    std::vector<float> pulses_;
+    std::vector<float> draw_x_;
+    std::vector<float> draw_y_;
     double last_time_;
-
-    void initPoints() {
-        points_.clear();
-        for (int i = 0; i < kNumPoints; ++i) {
-            Node p;
-            p.pos = visage::Point(random_float(0, width()), random_float(0, height()));
-            
-            float angle = random_float(0, 6.283f);
-            float speed = random_float(kMaxSpeed * 0.5f, kMaxSpeed);
-            p.vel = visage::Point(cos(angle) * speed, sin(angle) * speed);
-
-            p.unique_offset = random_float(0, 100.0f);
-            points_.push_back(p);
-        }
-    }
+    int num_points_ = kNumPoints;
+    bool pipelined_ = false;
+    bool show_pipeline_stats_ = false;
+    SpatialGrid grid_;
+    InstanceBatch batch_;
+    std::vector<float> line_x1_;
+    std::vector<float> line_y1_;
+    std::vector<float> line_x2_;
+    std::vector<float> line_y2_;
+    std::vector<float> connection_alphas_;
+    ScheduledAnimation animation_{ this };
 
     void updatePoints(float dt) {
         // If no time has passed, do nothing.
@@ -114,88 +247,87 @@ private:
             dt = 1.0f / 60.0f;
         }
         
-        for (auto& p : points_) {
-            p.pos = p.pos + p.vel * dt;
-
-            if (p.pos.x < 0) { p.pos.x = 0; p.vel.x *= -1; }
-            if (p.pos.x > width()) { p.pos.x = width(); p.vel.x *= -1; }
-            if (p.pos.y < 0) { p.pos.y = 0; p.vel.y *= -1; }
-            if (p.pos.y > height()) { p.pos.y = height(); p.vel.y *= -1; }
-        }
+        pipeline_.simulation().step(dt);
     }
 
-    void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-        visage::Point delta = p2 - p1;
-        float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
-        if (length < 1e-6f) return;
-
-        visage::Point perp(-delta.y / length, delta.x / length);
-        float half_thickness = thickness / 2.0f;
-
-        visage::Point v1 = p1 + perp * half_thickness;
-        visage::Point v2 = p2 + perp * half_thickness;
-        visage::Point v3 = p2 - perp * half_thickness;
-        visage::Point v4 = p1 - perp * half_thickness;
+    void drawPipelined(visage::Canvas& canvas) {
+        pipeline_.beginRender();
+        float alpha = pipeline_.update();
+
+        // Nodes keep their order between steps, so each one is a plain lerp.
+        const Snapshot& previous = pipeline_.previous();
+        const Snapshot& current = pipeline_.current();
+        int count = static_cast<int>(std::min(previous.x.size(), current.x.size()));
+        count = std::min(count, num_points_);
+        draw_x_.resize(count);
+        draw_y_.resize(count);
+        for (int i = 0; i < count; ++i) {
+            draw_x_[i] = previous.x[i] + (current.x[i] - previous.x[i]) * alpha;
+            draw_y_[i] = previous.y[i] + (current.y[i] - previous.y[i]) * alpha;
+        }
 
-        canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-        canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
+        drawConnections(canvas, draw_x_.data(), draw_y_.data(), count);
+        drawPoints(canvas, draw_x_.data(), draw_y_.data(), current.phase.data(), count);
+        if (show_pipeline_stats_)
+            drawPipelineStats(canvas, pipeline_.stats(), width());
+        pipeline_.endRender();
     }
 
-    void drawConnections(visage::Canvas& canvas) const {
-        visage::Color line_color = 0xff76b900;
-
-        for (size_t i = 0; i < points_.size(); ++i) {
-            for (size_t j = i + 1; j < points_.size(); ++j) {
-                const auto& p1 = points_[i];
-                const auto& p2 = points_[j];
-
-                float dist = point_distance(p1.pos, p2.pos);
-
-                if (dist < kConnectionDist) {
-                    float alpha = (1.0f - dist / kConnectionDist);
-                    
-                    line_color.setAlpha(static_cast<uint8_t>(alpha * 100));
-                    canvas.setColor(line_color);
-                    
-                    drawThickLine(canvas, p1.pos, p2.pos, 1.0f);
-                }
-            }
-        }
+    void drawConnections(visage::Canvas& canvas, const float* xs, const float* ys, int count) {
+        // Every edge goes into one instanced line batch; only their alpha differs.
+        line_x1_.clear();
+        line_y1_.clear();
+        line_x2_.clear();
+        line_y2_.clear();
+        connection_alphas_.clear();
+        grid_.build(count, width(), height(), kConnectionDist,
+                    [&](int i) { return visage::Point(xs[i], ys[i]); });
+        grid_.forEachPairWithin(kConnectionDist, [&](int i, int j, float dist_sq) {
+            // Only pairs that will actually be drawn pay for the sqrt.
+            float alpha = (1.0f - std::sqrt(dist_sq) / kConnectionDist);
+            connection_alphas_.push_back(alpha * kMaxConnectionAlpha);
+            line_x1_.push_back(xs[i]);
+            line_y1_.push_back(ys[i]);
+            line_x2_.push_back(xs[j]);
+            line_y2_.push_back(ys[j]);
+        });
+
+        LineInstances lines;
+        lines.x1 = line_x1_.data();
+        lines.y1 = line_y1_.data();
+        lines.x2 = line_x2_.data();
+        lines.y2 = line_y2_.data();
+        lines.thickness = 1.0f;
+        lines.alpha = connection_alphas_.data();
+        lines.count = static_cast<int>(connection_alphas_.size());
+        batch_.drawLines(canvas, lines);
     }
     
-    void drawPoints(visage::Canvas& canvas) const {
-        visage::Color point_color = 0xff76b900;
-        double current_time = canvas.time();
-
-        for (const auto& p : points_) {
-            float pulse = sin(current_time * 2.0f + p.unique_offset);
-            pulse = (pulse + 1.0f) * 0.5f;
-            pulse = pow(pulse, 4.0f);
-            
-            point_color.setHdr(1.0f + pulse * 1.5f);
-            point_color.setAlpha(255);
-
-            canvas.setColor(point_color);
-            canvas.circle(p.pos.x, p.pos.y, 2.0f);
-        }
+    void drawPoints(visage::Canvas& canvas, const float* xs, const float* ys, const float* phases, int count) {
+        // Wrap the shared angle in double so the float kernel keeps its precision.
+        double angle = std::fmod(canvas.time() * 2.0, 6.283185307179586);
+        pulses_.resize(count);
+        computePulses(phases, 0, count, static_cast<float>(angle), pulses_.data());
+        scaleBoosts(pulses_.data(), count, 1.0f, 1.5f, pulses_.data());
+
+        CircleInstances circles;
+        circles.x = xs;
+        circles.y = ys;
+        circles.constant_radius = 1.0f;
+        circles.hdr = pulses_.data();
+        circles.count = count;
+        batch_.drawCircles(canvas, circles);
     }
 };
 
 /**
  * @class NeuralNetVisage
- * @brief A container Frame that applies a bloom post-processing effect.
+ * @brief A container Frame for the node web. Its glow comes from the app's
+ *        shared bloom, picking up the nodes' HDR pulses.
  */
 class NeuralNetVisage : public visage::Frame {
 public:
     NeuralNetVisage() {
-        // IMPORTANT: Seed the random number generator once in your main() function
-        // by adding the line: srand(time(NULL));
-        srand(time(NULL));
-
-        bloom_.setBloomSize(40.0f);
-        bloom_.setBloomIntensity(1.0f); 
-        setPostEffect(&bloom_);
-
         addChild(&web_frame_);
         web_frame_.layout().setMargin(0);
 
@@ -211,7 +343,8 @@ public:
         web_frame_.layout().setHeight(height());
     }
 
+    SimplifiedWebFrame& webFrame() { return web_frame_; }
+
 private:
-    visage::BloomPostEffect bloom_;
     SimplifiedWebFrame web_frame_;
 };
\ No newline at end of file
@@ -30,15 +30,28 @@
 #include "visage/windowing.h"
 #include "visage/graphics.h"
 #include "visage/ui.h"
+#include "stroke.h"
+#include "catmull_rom.h"
+#include "geometry_cache.h"
+#include "boost.h"
+#include "particles.h"
+#include "random.h"
+#include "worker_pool.h"
+#include "simulation_pipeline.h"
+#include "instance_batch.h"
+#include "animation_scheduler.h"
 #include <vector>
 #include <cmath>
 #include <algorithm> // For std::max and std::min
+#include <ctime>
 
 class AnimationLineLeft : public visage::Frame {
 public:
   static constexpr int kNumPoints = 3; // Number of base vertices for the triangle
   static constexpr float kDotRadius = 4.0f; // No longer used, but constant can remain.
   static constexpr float TAU = 6.28318530718f; // 2 * PI
+  static constexpr float kDefaultSplineTolerance = 0.25f; // Pixels
+  static constexpr float kBoostFalloff = 8.0f; // Boost reaches zero 1/8 of the loop from its peak
 
   static inline float quickSin1(float phase) {
     phase = 0.5f - phase;
@@ -56,15 +69,29 @@ public:
   }
 
   void resized() override {
-    // No specific resized logic needed here as drawing is responsive to width/height
+    // The inner border is cached per size; everything else is responsive to width/height
+    inner_border_.invalidate();
+  }
+
+  // Maximum distance in pixels between the drawn polyline and the true spline.
+  // Zero falls back to a fixed kNumSplineSegments per span.
+  void setSplineTolerance(float tolerance) {
+    boosted_stroke_.setTolerance(tolerance);
+    inner_border_.invalidate();
   }
+  float splineTolerance() const { return boosted_stroke_.tolerance(); }
+  // Multiplies how far the line's HDR rises above 1, i.e. how strongly the shared bloom picks it up.
+  void setBloomStrength(float strength) { bloom_strength_ = strength; }
+  // Stroke segments emitted by the last draw, across the border and the triangle.
+  int emittedSegments() const { return boosted_stroke_.emittedSegments(); }
 
   void draw(visage::Canvas& canvas) override {
-    static constexpr int kNumSplineSegments = 50; // More segments for smoother spline curves
+    static constexpr int kNumSplineSegments = 50; // Most segments a span may use; also the fixed count when the tolerance is 0
 
     double render_time = canvas.time();
     int render_height = height();
     int render_width = width();
+    boosted_stroke_.resetEmittedSegments();
 
     // --- Animation Parameters for Boosting (Direction Reversed) ---
     float boost_time = render_time * 0.2f;
@@ -72,10 +99,11 @@ public:
 
     auto compute_boost = [](float dist) {
         // This function outputs a value from 0.0 to 1.0 (or slightly more)
-        return std::max(0.0f, 1.0f - 8.0f * std::abs(dist));
+        return std::max(0.0f, 1.0f - kBoostFalloff * std::abs(dist));
     };
 
-    const float BOOST_INTENSITY_MULTIPLIER = 2.0f; // How much the color brightens
+    // How much the color brightens; the bloom strength scales the part that glows.
+    const float BOOST_INTENSITY_MULTIPLIER = 2.0f * bloom_strength_;
 
 
     // --- Button Background ---
@@ -114,50 +142,38 @@ public:
         return visage::Point(scaled_x, scaled_y);
     };
 
-    std::vector<visage::Point> inner_border_spline_control_points;
-    inner_border_spline_control_points.reserve(8 + 3);
-
-// Define the 8 key points on the perimeter, going counter-clockwise:
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, corner_radius)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, render_height - corner_radius)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, render_height)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, render_height)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, render_height - corner_radius)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, corner_radius)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, 0)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, 0)));
-
-    // Add the first three points to close the spline loop
-    inner_border_spline_control_points.push_back(inner_border_spline_control_points[0]);
-    inner_border_spline_control_points.push_back(inner_border_spline_control_points[1]);
-    inner_border_spline_control_points.push_back(inner_border_spline_control_points[2]);
-
+    // The inner border only depends on the frame size, so it is sampled and tessellated
+    // once per size; each frame just re-widths and recolours it.
     const int kNumInnerBorderSplineSegments = 8;
-    for (int i = 0; i < kNumInnerBorderSplineSegments; ++i) {
-        visage::Point p0 = inner_border_spline_control_points[i];
-        visage::Point p1 = inner_border_spline_control_points[i + 1];
-        visage::Point p2 = inner_border_spline_control_points[i + 2];
-        visage::Point p3 = inner_border_spline_control_points[i + 3];
-
-        visage::Point current_spline_point = p1;
-
-        for (int j = 1; j <= kNumSplineSegments; ++j) {
-            float t = static_cast<float>(j) / kNumSplineSegments;
-            float border_total_t = (static_cast<float>(i) + t) / kNumInnerBorderSplineSegments;
-
-            // REVERSED BOOST DIRECTION: Use 'border_total_t - boost_phase' for opposite
-            float current_boost = compute_boost(border_total_t - boost_phase);
-
-            visage::Point next_spline_point = splineInterpolation(p0, p1, p2, p3, t);
-            visage::Color boostedInnerBorderColor = innerBorderBaseColor;
-            boostedInnerBorderColor.setHdr(1.0f + current_boost * BOOST_INTENSITY_MULTIPLIER);
-
-            canvas.setColor(boostedInnerBorderColor);
-            drawThickLine(canvas, current_spline_point, next_spline_point, inner_border_thickness_base + current_boost * 1.0f);
-
-            current_spline_point = next_spline_point;
-        }
+    if (inner_border_.needsRebuild(render_width, render_height)) {
+        std::vector<visage::Point> inner_border_spline_control_points;
+        inner_border_spline_control_points.reserve(8 + 3);
+
+        // Define the 8 key points on the perimeter, going counter-clockwise:
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, corner_radius)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, render_height - corner_radius)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, render_height)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, render_height)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, render_height - corner_radius)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, corner_radius)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, 0)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, 0)));
+
+        // Add the first three points to close the spline loop
+        inner_border_spline_control_points.push_back(inner_border_spline_control_points[0]);
+        inner_border_spline_control_points.push_back(inner_border_spline_control_points[1]);
+        inner_border_spline_control_points.push_back(inner_border_spline_control_points[2]);
+
+        boosted_stroke_.sample(inner_border_spline_control_points, kNumInnerBorderSplineSegments, kNumSplineSegments,
+                               inner_border_.points(), inner_border_.params());
+        inner_border_.mesh().clear();
+        inner_border_.mesh().addPolyline(inner_border_.points().data(), static_cast<int>(inner_border_.points().size()),
+                                         true, inner_border_thickness_base);
+        inner_border_.markBuilt(render_width, render_height);
     }
+    boosted_stroke_.draw(canvas, inner_border_.mesh(), inner_border_.params(),
+                         innerBorderBaseColor, inner_border_thickness_base, 1.0f, BOOST_INTENSITY_MULTIPLIER,
+                         boost_phase, kBoostFalloff);
 
 
     // --- Define base triangle properties ---
@@ -201,81 +217,22 @@ public:
     visage::Color triangleColor = 0xff76b900; // NVIDIA green
     float triangleBorderWidth_base = 3.0f;
 
-    for (int i = 0; i < kNumPoints; ++i) {
-        visage::Point p0 = triangle_spline_control_points[i];
-        visage::Point p1 = triangle_spline_control_points[i + 1];
-        visage::Point p2 = triangle_spline_control_points[i + 2];
-        visage::Point p3 = triangle_spline_control_points[i + 3];
-
-        visage::Point current_spline_point = p1;
-
-        for (int j = 1; j <= kNumSplineSegments; ++j) {
-            float t = static_cast<float>(j) / kNumSplineSegments;
-            float segment_t = (static_cast<float>(i) + t) / kNumPoints;
-
-            // REVERSED BOOST DIRECTION: 'segment_t - boost_phase' for opposite
-            float current_boost = compute_boost(segment_t - boost_phase);
-
-            visage::Point next_spline_point = splineInterpolation(p0, p1, p2, p3, t);
-            visage::Color boostedColor = triangleColor;
-            boostedColor.setHdr(1.0f + current_boost * BOOST_INTENSITY_MULTIPLIER);
-
-            canvas.setColor(boostedColor);
-            drawThickLine(canvas, current_spline_point, next_spline_point, triangleBorderWidth_base + current_boost * 1.5f);
-
-            current_spline_point = next_spline_point;
-        }
-    }
-
-    redraw();
+    boosted_stroke_.sample(triangle_spline_control_points, kNumPoints, kNumSplineSegments, spline_points_, spline_params_);
+    stroke_.clear();
+    stroke_.addPolyline(spline_points_.data(), static_cast<int>(spline_points_.size()), true, triangleBorderWidth_base);
+    boosted_stroke_.draw(canvas, stroke_, spline_params_,
+                         triangleColor, triangleBorderWidth_base, 1.5f, BOOST_INTENSITY_MULTIPLIER,
+                         boost_phase, kBoostFalloff);
   }
 
 private:
-    void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-        visage::Point delta = p2 - p1;
-        float length = sqrt(delta.x * delta.x + delta.y * delta.y);
-        if (length < 1e-6f) return;
-
-        visage::Point perp( -delta.y * (1.0f/length), delta.x * (1.0f/length) );
-        float half_thickness = thickness / 2.0f;
-
-        visage::Point v1 = p1 + perp * half_thickness;
-        visage::Point v2 = p2 + perp * half_thickness;
-        visage::Point v3 = p2 - perp * half_thickness;
-        visage::Point v4 = p1 - perp * half_thickness;
-
-        canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-        canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
-    }
-
-    visage::Point splineInterpolation(visage::Point p0, visage::Point p1, visage::Point p2, visage::Point p3, float t, float tension = 0.0f, float alpha = 0.5f) const {
-        auto distance = [](visage::Point a, visage::Point b) {
-            return sqrt(pow(a.x - b.x, 2) + pow(a.y - b.y, 2));
-        };
-
-        float t01 = pow(distance(p0, p1), alpha);
-        float t12 = pow(distance(p1, p2), alpha);
-        float t23 = pow(distance(p2, p3), alpha);
-
-        if (t01 < 1e-6f) t01 = 1.0f;
-        if (t12 < 1e-6f) t12 = 1.0f;
-        if (t23 < 1e-6f) t23 = 1.0f;
-
-        float inv_t01 = 1.0f / t01;
-        float inv_t23 = 1.0f / t23;
-        float inv_t01_t12 = 1.0f / (t01 + t12);
-        float inv_t12_t23 = 1.0f / (t12 + t23);
-
-        visage::Point m1 = (p2 - p1 + (p1 - p0) * inv_t01 * t12 - (p2 - p0) * inv_t01_t12 * t12) * (1.0f - tension);
-        visage::Point m2 = (p2 - p1 + (p3 - p2) * inv_t23 * t12 - (p3 - p1) * inv_t12_t23 * t12) * (1.0f - tension);
-
-        visage::Point a = (p1 - p2) * 2.0f + m1 + m2;
-        visage::Point b = (p1 - p2) * -3.0f - m1 - m1 - m2;
-        visage::Point c = m1;
-        visage::Point d = p1;
-
-        return a * t * t * t + b * t * t + c * t + d;
-    }
+    StrokeGeometryCache inner_border_;
+    StrokeMesh stroke_;
+    std::vector<visage::Point> spline_points_;
+    std::vector<float> spline_params_;
+    BoostedSplineStroke boosted_stroke_{ kDefaultSplineTolerance };
+    float bloom_strength_ = 1.0f;
+    ScheduledAnimation animation_{ this, AnimationScheduler::kButtonFps };
 };
 
 class AnimatedLine : public visage::Frame {
@@ -283,6 +240,8 @@ public:
   static constexpr int kNumPoints = 3; // Number of base vertices for the triangle
   static constexpr float kDotRadius = 4.0f; // No longer used.
   static constexpr float TAU = 6.28318530718f; // 2 * PI
+  static constexpr float kDefaultSplineTolerance = 0.25f; // Pixels
+  static constexpr float kBoostFalloff = 8.0f; // Boost reaches zero 1/8 of the loop from its peak
 
   static inline float quickSin1(float phase) {
     phase = 0.5f - phase;
@@ -300,25 +259,40 @@ public:
   }
 
   void resized() override {
-    // No specific resized logic needed here as drawing is responsive to width/height
+    // The inner border is cached per size; everything else is responsive to width/height
+    inner_border_.invalidate();
+  }
+
+  // Maximum distance in pixels between the drawn polyline and the true spline.
+  // Zero falls back to a fixed kNumSplineSegments per span.
+  void setSplineTolerance(float tolerance) {
+    boosted_stroke_.setTolerance(tolerance);
+    inner_border_.invalidate();
   }
+  float splineTolerance() const { return boosted_stroke_.tolerance(); }
+  // Multiplies how far the line's HDR rises above 1, i.e. how strongly the shared bloom picks it up.
+  void setBloomStrength(float strength) { bloom_strength_ = strength; }
+  // Stroke segments emitted by the last draw, across the border and the triangle.
+  int emittedSegments() const { return boosted_stroke_.emittedSegments(); }
 
   void draw(visage::Canvas& canvas) override {
-    static constexpr int kNumSplineSegments = 50; // More segments for smoother triangle spline curves
+    static constexpr int kNumSplineSegments = 50; // Most segments a span may use; also the fixed count when the tolerance is 0
 
     double render_time = canvas.time();
     int render_height = height();
     int render_width = width();
+    boosted_stroke_.resetEmittedSegments();
 
     // --- Animation Parameters for Boosting ---
     float boost_time = render_time * 0.2f;
     float boost_phase = (boost_time - floor(boost_time)) * 1.5f - 0.25f;
 
     auto compute_boost = [](float dist) {
-        return std::max(0.0f, 1.0f - 8.0f * std::abs(dist));
+        return std::max(0.0f, 1.0f - kBoostFalloff * std::abs(dist));
     };
 
-    const float BOOST_INTENSITY_MULTIPLIER = 2.0f; // Used for how much the color brightens
+    // Used for how much the color brightens; the bloom strength scales the part that glows.
+    const float BOOST_INTENSITY_MULTIPLIER = 2.0f * bloom_strength_;
 
 
     // --- Button Background ---
@@ -363,50 +337,39 @@ public:
         return visage::Point(scaled_x, scaled_y);
     };
 
-    std::vector<visage::Point> inner_border_spline_control_points;
-    inner_border_spline_control_points.reserve(8 + 3);
-
-    // Define the 8 key points on the perimeter, going clockwise:
-    // Scale and center these points
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, 0)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, 0)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, corner_radius)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, render_height - corner_radius)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, render_height)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, render_height)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, render_height - corner_radius)));
-    inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, corner_radius)));
-
-    // Add the first three points to close the spline loop
-    inner_border_spline_control_points.push_back(inner_border_spline_control_points[0]);
-    inner_border_spline_control_points.push_back(inner_border_spline_control_points[1]);
-    inner_border_spline_control_points.push_back(inner_border_spline_control_points[2]);
-
+    // The inner border only depends on the frame size, so it is sampled and tessellated
+    // once per size; each frame just re-widths and recolours it.
     const int kNumInnerBorderSplineSegments = 8;
-    for (int i = 0; i < kNumInnerBorderSplineSegments; ++i) {
-        visage::Point p0 = inner_border_spline_control_points[i];
-        visage::Point p1 = inner_border_spline_control_points[i + 1];
-        visage::Point p2 = inner_border_spline_control_points[i + 2];
-        visage::Point p3 = inner_border_spline_control_points[i + 3];
-
-        visage::Point current_spline_point = p1;
-
-        for (int j = 1; j <= kNumSplineSegments; ++j) {
-            float t = static_cast<float>(j) / kNumSplineSegments;
-            visage::Point next_spline_point = splineInterpolation(p0, p1, p2, p3, t);
-
-            float border_total_t = (static_cast<float>(i) + t) / kNumInnerBorderSplineSegments;
-            float current_boost = compute_boost(boost_phase - border_total_t);
-
-            visage::Color boostedInnerBorderColor = innerBorderBaseColor;
-            boostedInnerBorderColor.setHdr(1.0f + current_boost * BOOST_INTENSITY_MULTIPLIER);
-
-            canvas.setColor(boostedInnerBorderColor);
-            drawThickLine(canvas, current_spline_point, next_spline_point, inner_border_thickness_base + current_boost * 1.0f); // Boost thickness scaled for inner border
-
-            current_spline_point = next_spline_point;
-        }
+    if (inner_border_.needsRebuild(render_width, render_height)) {
+        std::vector<visage::Point> inner_border_spline_control_points;
+        inner_border_spline_control_points.reserve(8 + 3);
+
+        // Define the 8 key points on the perimeter, going clockwise:
+        // Scale and center these points
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, 0)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, 0)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, corner_radius)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width, render_height - corner_radius)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(render_width - corner_radius, render_height)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(corner_radius, render_height)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, render_height - corner_radius)));
+        inner_border_spline_control_points.push_back(scaleAndCenterPoint(visage::Point(0, corner_radius)));
+
+        // Add the first three points to close the spline loop
+        inner_border_spline_control_points.push_back(inner_border_spline_control_points[0]);
+        inner_border_spline_control_points.push_back(inner_border_spline_control_points[1]);
+        inner_border_spline_control_points.push_back(inner_border_spline_control_points[2]);
+
+        boosted_stroke_.sample(inner_border_spline_control_points, kNumInnerBorderSplineSegments, kNumSplineSegments,
+                               inner_border_.points(), inner_border_.params());
+        inner_border_.mesh().clear();
+        inner_border_.mesh().addPolyline(inner_border_.points().data(), static_cast<int>(inner_border_.points().size()),
+                                         true, inner_border_thickness_base);
+        inner_border_.markBuilt(render_width, render_height);
     }
+    boosted_stroke_.draw(canvas, inner_border_.mesh(), inner_border_.params(),
+                         innerBorderBaseColor, inner_border_thickness_base, 1.0f, BOOST_INTENSITY_MULTIPLIER,
+                         boost_phase, kBoostFalloff);
 
 
     // --- Define base triangle properties ---
@@ -446,81 +409,22 @@ public:
     visage::Color triangleColor = 0xff76b900; // NVIDIA green
     float triangleBorderWidth_base = 3.0f;
 
-    for (int i = 0; i < kNumPoints; ++i) {
-        visage::Point p0 = triangle_spline_control_points[i];
-        visage::Point p1 = triangle_spline_control_points[i + 1];
-        visage::Point p2 = triangle_spline_control_points[i + 2];
-        visage::Point p3 = triangle_spline_control_points[i + 3];
-
-        visage::Point current_spline_point = p1;
-
-        for (int j = 1; j <= kNumSplineSegments; ++j) {
-            float t = static_cast<float>(j) / kNumSplineSegments;
-            visage::Point next_spline_point = splineInterpolation(p0, p1, p2, p3, t);
-
-            float segment_t = (static_cast<float>(i) + t) / kNumPoints;
-            float current_boost = compute_boost(boost_phase - segment_t);
-
-            visage::Color boostedColor = triangleColor;
-            boostedColor.setHdr(1.0f + current_boost * BOOST_INTENSITY_MULTIPLIER);
-
-            canvas.setColor(boostedColor);
-            drawThickLine(canvas, current_spline_point, next_spline_point, triangleBorderWidth_base + current_boost * 1.5f);
-
-            current_spline_point = next_spline_point;
-        }
-    }
-
-    redraw();
+    boosted_stroke_.sample(triangle_spline_control_points, kNumPoints, kNumSplineSegments, spline_points_, spline_params_);
+    stroke_.clear();
+    stroke_.addPolyline(spline_points_.data(), static_cast<int>(spline_points_.size()), true, triangleBorderWidth_base);
+    boosted_stroke_.draw(canvas, stroke_, spline_params_,
+                         triangleColor, triangleBorderWidth_base, 1.5f, BOOST_INTENSITY_MULTIPLIER,
+                         boost_phase, kBoostFalloff);
   }
 
 private:
-    void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-        visage::Point delta = p2 - p1;
-        float length = sqrt(delta.x * delta.x + delta.y * delta.y);
-        if (length < 1e-6f) return;
-
-        visage::Point perp( -delta.y * (1.0f/length), delta.x * (1.0f/length) );
-        float half_thickness = thickness / 2.0f;
-
-        visage::Point v1 = p1 + perp * half_thickness;
-        visage::Point v2 = p2 + perp * half_thickness;
-        visage::Point v3 = p2 - perp * half_thickness;
-        visage::Point v4 = p1 - perp * half_thickness;
-
-        // Draws a rectangle by using two triangles to form the thick line
-        canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-        canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
-    }
-
-    visage::Point splineInterpolation(visage::Point p0, visage::Point p1, visage::Point p2, visage::Point p3, float t, float tension = 0.0f, float alpha = 0.5f) const {
-        auto distance = [](visage::Point a, visage::Point b) {
-            return sqrt(pow(a.x - b.x, 2) + pow(a.y - b.y, 2));
-        };
-
-        float t01 = pow(distance(p0, p1), alpha);
-        float t12 = pow(distance(p1, p2), alpha);
-        float t23 = pow(distance(p2, p3), alpha);
-
-        if (t01 < 1e-6f) t01 = 1.0f;
-        if (t12 < 1e-6f) t12 = 1.0f;
-        if (t23 < 1e-6f) t23 = 1.0f;
-
-        float inv_t01 = 1.0f / t01;
-        float inv_t23 = 1.0f / t23;
-        float inv_t01_t12 = 1.0f / (t01 + t12);
-        float inv_t12_t23 = 1.0f / (t12 + t23);
-
-        visage::Point m1 = (p2 - p1 + (p1 - p0) * inv_t01 * t12 - (p2 - p0) * inv_t01_t12 * t12) * (1.0f - tension);
-        visage::Point m2 = (p2 - p1 + (p3 - p2) * inv_t23 * t12 - (p3 - p1) * inv_t12_t23 * t12) * (1.0f - tension);
-
-        visage::Point a = (p1 - p2) * 2.0f + m1 + m2;
-        visage::Point b = (p1 - p2) * -3.0f - m1 - m1 - m2;
-        visage::Point c = m1;
-        visage::Point d = p1;
-
-        return a * t * t * t + b * t * t + c * t + d;
-    }
+    StrokeGeometryCache inner_border_;
+    StrokeMesh stroke_;
+    std::vector<visage::Point> spline_points_;
+    std::vector<float> spline_params_;
+    BoostedSplineStroke boosted_stroke_{ kDefaultSplineTolerance };
+    float bloom_strength_ = 1.0f;
+    ScheduledAnimation animation_{ this, AnimationScheduler::kButtonFps };
 };
 class AnimatedFrame : public visage::Frame { // Inherit directly from visage::Frame
 public:
@@ -528,10 +432,6 @@ public:
         m_width = _width;
         m_height = _height;
 
-        bloom_.setBloomSize(40.0f);
-        bloom_.setBloomIntensity(1.0f);
-        setPostEffect(&bloom_);
-
         addChild(&animated_line_);
         animated_line_.layout().setMargin(0);
 
@@ -571,11 +471,14 @@ public:
         redraw(); // Request a redraw to apply the new size
     }
 
+    // The line glows through the app's shared bloom; see AnimatedLine::setBloomStrength.
+    void setBloomStrength(float strength) { animated_line_.setBloomStrength(strength); }
+    void setSplineTolerance(float tolerance) { animated_line_.setSplineTolerance(tolerance); }
+
     int m_width = 800;
     int m_height = 600;
 private:
     visage::Palette palette_;
-    visage::BloomPostEffect bloom_;
     AnimatedLine animated_line_;
     // Button previous_button_; // Uncomment if you have button.h
     // Button next_button_;     // Uncomment if you have button.h
@@ -588,10 +491,6 @@ public:
         m_width = _width;
         m_height = _height;
 
-        bloom_.setBloomSize(40.0f);
-        bloom_.setBloomIntensity(1.0f);
-        setPostEffect(&bloom_);
-
         addChild(&animated_line_);
         animated_line_.layout().setMargin(0);
 
@@ -631,11 +530,14 @@ public:
         redraw(); // Request a redraw to apply the new size
     }
 
+    // The line glows through the app's shared bloom; see AnimatedLine::setBloomStrength.
+    void setBloomStrength(float strength) { animated_line_.setBloomStrength(strength); }
+    void setSplineTolerance(float tolerance) { animated_line_.setSplineTolerance(tolerance); }
+
     int m_width = 800;
     int m_height = 600;
 private:
     visage::Palette palette_;
-    visage::BloomPostEffect bloom_;
     AnimationLineLeft animated_line_;
     // Button previous_button_; // Uncomment if you have button.h
     // Button next_button_;     // Uncomment if you have button.h
@@ -689,28 +591,9 @@ public:
     // Using black color and a thin line width
     
     drawRootingLines(canvas, 0xFF000000, points, NUM_ROOTING_LINES, center, current_rotation_angle);
-
-    redraw(); // Keep redrawing to animate
   }
 
 private:
-    void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-        visage::Point delta = p2 - p1;
-        float length = sqrt(delta.x * delta.x + delta.y * delta.y);
-        if (length < 1e-6f) return; // Avoid division by zero
-
-        visage::Point perp( -delta.y * (1.0f/length), delta.x * (1.0f/length) );
-        float half_thickness = thickness / 2.0f;
-
-        visage::Point v1 = p1 + perp * half_thickness;
-        visage::Point v2 = p2 + perp * half_thickness;
-        visage::Point v3 = p2 - perp * half_thickness;
-        visage::Point v4 = p1 - perp * half_thickness;
-
-        canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-        canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
-    }
-
     /**
      * Generates control points for a closed, deformed circle using a sine wave
      * for displacement, creating a "wobble" effect.
@@ -739,45 +622,13 @@ private:
         return p;
     }
 
-    // Catmull-Rom spline interpolation
-    visage::Point splineInterpolation(visage::Point p0, visage::Point p1, visage::Point p2, visage::Point p3, float t, float tension = 0.0f, float alpha = 0.5f) const {
-        auto distance = [](visage::Point a, visage::Point b) {
-            return sqrt(pow(a.x - b.x, 2) + pow(a.y - b.y, 2));
-        };
-
-        float t01 = pow(distance(p0, p1), alpha);
-        float t12 = pow(distance(p1, p2), alpha);
-        float t23 = pow(distance(p2, p3), alpha);
-
-        // Handle cases where points are extremely close to avoid division by zero
-        if (t01 < 1e-6f) t01 = 1.0f;
-        if (t12 < 1e-6f) t12 = 1.0f;
-        if (t23 < 1e-6f) t23 = 1.0f;
-
-        float inv_t01 = 1.0f / t01;
-        float inv_t23 = 1.0f / t23;
-        float inv_t01_t12 = 1.0f / (t01 + t12);
-        float inv_t12_t23 = 1.0f / (t12 + t23);
-
-        visage::Point m1 = (p2 - p1 + (p1 - p0) * inv_t01 * t12 - (p2 - p0) * inv_t01_t12 * t12) * (1.0f - tension);
-        visage::Point m2 = (p2 - p1 + (p3 - p2) * inv_t23 * t12 - (p3 - p1) * inv_t12_t23 * t12) * (1.0f - tension);
-
-        // Coefficients for the cubic polynomial
-        visage::Point a_coeff = (p1 - p2) * 2.0f + m1 + m2;
-        visage::Point b_coeff = (p1 - p2) * -3.0f - m1 - m1 - m2;
-        visage::Point c_coeff = m1;
-        visage::Point d_coeff = p1;
-
-        // Evaluate the cubic polynomial
-        return a_coeff * t * t * t + b_coeff * t * t + c_coeff * t + d_coeff;
-    }
-
     // Draws rooting lines from the center to points on the deformed circle
-    void drawRootingLines(visage::Canvas& canvas, unsigned int drawColor, const std::vector<visage::Point>& deformedPoints, int numLines, visage::Point center, float rotation_angle) const {
+    void drawRootingLines(visage::Canvas& canvas, unsigned int drawColor, const std::vector<visage::Point>& deformedPoints, int numLines, visage::Point center, float rotation_angle) {
         if (deformedPoints.empty() || numLines <= 0) return;
 
         canvas.setColor(drawColor);
         float lineWidth = 1.5f; // Thin lines for the "rooting" effect
+        stroke_.clear();
 
         for (int i = 0; i < numLines; ++i) {
             // Pick points evenly distributed around the deformed circle
@@ -797,9 +648,10 @@ private:
 
             visage::Point rotated_outer_point(center.x + rotated_dx, center.y + rotated_dy);
 
-            // Draw a line from the center to the rotated outer point
-            drawThickLine(canvas, center, rotated_outer_point, lineWidth);
+            // Add a line from the center to the rotated outer point
+            stroke_.addSegment(center, rotated_outer_point, lineWidth);
         }
+        stroke_.draw(canvas);
     }
 
     // Optional: Draws small circles at each control point
@@ -810,6 +662,9 @@ private:
             canvas.circle(p[i].x - 4.0f, p[i].y - 4.0f, 8.0f); // Draw a circle at the point's center
         }
     }
+
+    StrokeMesh stroke_;
+    ScheduledAnimation animation_{ this };
 };
 
 class RotatingShardsAnimation : public visage::Frame {
@@ -849,6 +704,10 @@ public:
     visage::Point center(render_width / 2.0f, render_height / 2.0f);
     float min_dim = std::min(render_width, render_height);
 
+    // Every arc of every ring goes into one stroke; colours are looked up per arc at draw time.
+    stroke_.clear();
+    visage::Color arc_colors[kNumRings * kSegmentsPerRing];
+
     for (int i = 0; i < kNumRings; ++i) {
       // Calculate radius for this ring
       float ring_progress = static_cast<float>(i) / (kNumRings - 1); // 0.0 to 1.0
@@ -876,64 +735,36 @@ public:
         unsigned int segment_color_base = (j % 2 == 0) ? kNvidiaGreen : kDarkGrey;
         visage::Color segment_color = segment_color_base;
         segment_color.setAlpha(static_cast<unsigned char>(255 * alpha_multiplier));
+        arc_colors[i * kSegmentsPerRing + j] = segment_color;
 
-        canvas.setColor(segment_color);
-
-        // Draw the arc segment using small lines
-        visage::Point prev_point;
-        const int kArcResolution = 10; // Number of sub-segments to draw an arc smoothly
-
+        // Build the arc segment as a short polyline
+        visage::Point arc_points[kArcResolution + 1];
         for (int k = 0; k <= kArcResolution; ++k) {
           float t = static_cast<float>(k) / kArcResolution;
           float angle = segment_start_angle + (segment_end_angle - segment_start_angle) * t;
 
-          visage::Point current_point(center.x + current_radius * cos(angle),
-                                      center.y + current_radius * sin(angle));
-
-          if (k > 0) {
-            drawThickLine(canvas, prev_point, current_point, kLineWidth);
-          }
-          prev_point = current_point;
+          arc_points[k] = visage::Point(center.x + current_radius * cos(angle),
+                                        center.y + current_radius * sin(angle));
         }
+        stroke_.addPolyline(arc_points, kArcResolution + 1, false, kLineWidth);
       }
     }
 
-    redraw(); // Keep animating
+    // Each arc contributes kArcResolution segments.
+    stroke_.draw(canvas, [&](int segment) { return arc_colors[segment / kArcResolution]; });
   }
 
 private:
-  // Helper to draw a thick line (as Visage Canvas doesn't have setLineWidth for lines directly)
-  void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-    visage::Point delta = p2 - p1;
-    float length = sqrt(delta.x * delta.x + delta.y * delta.y);
-    if (length < 1e-6f) return; // Avoid division by zero
-
-    visage::Point perp(-delta.y * (1.0f / length), delta.x * (1.0f / length));
-    float half_thickness = thickness / 2.0f;
-
-    visage::Point v1 = p1 + perp * half_thickness;
-    visage::Point v2 = p2 + perp * half_thickness;
-    visage::Point v3 = p2 - perp * half_thickness;
-    visage::Point v4 = p1 - perp * half_thickness;
-
-    canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-    canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
-  }
+  static constexpr int kArcResolution = 10; // Number of sub-segments to draw an arc smoothly
+
+  StrokeMesh stroke_;
+  ScheduledAnimation animation_{ this };
 };
 class CosmicPulsarAnimation : public visage::Frame {
 public:
-  // A simple structure to hold the state of each particle
-  struct Particle {
-    visage::Point position;
-    visage::Point velocity;
-    float lifetime;
-    float initial_lifetime;
-    visage::Color color;
-  };
-
-  static constexpr int kMaxParticles = 200;       // Maximum number of particles on screen
+  static constexpr int kMaxParticles = 100000;    // Pool capacity; the most the budget can be raised to
+  static constexpr int kDefaultParticleBudget = 200; // Live particles on screen, emitted at 80 per second
   static constexpr float kParticleLifetime = 2.5f; // How long each particle lasts in seconds
-  static constexpr float kEmissionRate = 80.0f;   // How many particles to emit per second
   static constexpr float kParticleSpeed = 80.0f;  // Base speed of particles
   static constexpr float kBaseParticleRadius = 3.0f;
 
@@ -943,82 +774,228 @@ public:
   static constexpr unsigned int kColor1 = 0xff76b900; // NVIDIA Green
   static constexpr unsigned int kColor2 = 0xffc0c0c0; // Silver
 
-  CosmicPulsarAnimation() : time_accumulator_(0.0f) {
+  // What the renderer needs from one simulation step.
+  struct Snapshot {
+    std::vector<float> x, y, vx, vy, life_ratio;
+    std::vector<uint8_t> color_index;
+  };
+
+  /**
+   * Emission and particle motion, independent of drawing so it can be stepped
+   * either from draw() or by a SimulationPipeline.
+   */
+  class Simulation {
+  public:
+    Simulation() : random_(static_cast<uint64_t>(time(nullptr))) {
+      // All particle and scratch storage is allocated up front
+      particles_.setCapacity(kMaxParticles);
+      life_ratios_.resize(kMaxParticles);
+    }
+
+    void setCenter(visage::Point center) { center_ = center; }
+    void setSeed(uint64_t seed) { random_.setSeed(seed); }
+
+    // Caps live particles below the pool capacity; emission scales down to match.
+    // Lowering it lets the surplus die off naturally instead of culling it.
+    void setParticleBudget(int budget) { budget_ = std::min(std::max(budget, 0), kMaxParticles); }
+    int particleBudget() const { return budget_; }
+
+    void step(float delta_time) {
+      // Emit new particles based on time passed
+      float emission_rate = budget_ / kParticleLifetime;
+      time_accumulator_ += delta_time;
+      int particles_to_emit = static_cast<int>(time_accumulator_ * emission_rate);
+      if (particles_to_emit > 0) {
+        time_accumulator_ -= particles_to_emit / emission_rate;
+        emitParticles(particles_to_emit);
+      }
+
+      // Update existing particles across the worker pool. Dead particles get moved too,
+      // which is harmless, and lets aging and moving share one pass.
+      WorkerPool& pool = WorkerPool::shared();
+      pool.parallelFor(particles_.size(), [&](int begin, int end) {
+        particles_.age(delta_time, begin, end);
+        particles_.integrate(delta_time, begin, end);
+      });
+      particles_.removeDead();
+
+      // Fade out and shrink each particle as it ages
+      pool.parallelFor(particles_.size(), [&](int begin, int end) {
+        particles_.lifeRatios(life_ratios_.data(), begin, end);
+      });
+    }
+
+    void capture(Snapshot& snapshot) const {
+      int count = particles_.size();
+      snapshot.x.assign(particles_.x(), particles_.x() + count);
+      snapshot.y.assign(particles_.y(), particles_.y() + count);
+      snapshot.vx.assign(particles_.vx(), particles_.vx() + count);
+      snapshot.vy.assign(particles_.vy(), particles_.vy() + count);
+      snapshot.life_ratio.assign(life_ratios_.begin(), life_ratios_.begin() + count);
+      snapshot.color_index.assign(particles_.tag(), particles_.tag() + count);
+    }
+
+    const ParticleArrays& particles() const { return particles_; }
+    const float* lifeRatios() const { return life_ratios_.data(); }
+
+  private:
+    void emitParticles(int count) {
+      count = std::min(count, budget_ - particles_.size());
+      if (count <= 0) return;
+
+      // Draw every random value for this batch in a few vectorized calls.
+      emit_angles_.resize(count);
+      emit_speeds_.resize(count);
+      emit_lifetimes_.resize(count);
+      emit_colors_.resize(count);
+      random_.fillAngles(emit_angles_.data(), count);
+      random_.fillUniform(emit_speeds_.data(), count, kParticleSpeed * 0.8f, kParticleSpeed * 1.2f);
+      random_.fillUniform(emit_lifetimes_.data(), count, kParticleLifetime * 0.7f, kParticleLifetime * 1.3f);
+      // Pick one of the two colors randomly; the tag holds the color index
+      random_.fillUniform(emit_colors_.data(), count, 0.0f, 2.0f);
+
+      for (int i = 0; i < count; ++i) {
+        float speed = emit_speeds_[i];
+        particles_.add(center_.x, center_.y, cos(emit_angles_[i]) * speed, sin(emit_angles_[i]) * speed,
+                       emit_lifetimes_[i], 0.0f, static_cast<uint8_t>(emit_colors_[i]));
+      }
+    }
+
+    ParticleArrays particles_;
+    std::vector<float> life_ratios_;
+    FastRandom random_;
+    visage::Point center_;
+    int budget_ = kDefaultParticleBudget;
+    float time_accumulator_ = 0.0f;
+    std::vector<float> emit_angles_;
+    std::vector<float> emit_speeds_;
+    std::vector<float> emit_lifetimes_;
+    std::vector<float> emit_colors_;
+  };
+
+  CosmicPulsarAnimation() {
     setIgnoresMouseEvents(true, false);
+    const visage::Color palette[] = { kColor1, kColor2 };
+    batch_.setPalette(palette, 2);
+
+    // While hidden the simulation thread is stopped and the next draw restarts the
+    // time base, so the hidden period is not simulated as one huge step.
+    animation_.setCallbacks(
+        [this] {
+          pipeline_.stop();
+          last_time_ = 0;
+        },
+        [this] {
+          if (pipelined_)
+            pipeline_.start();
+        });
+  }
+
+  ~CosmicPulsarAnimation() override { pipeline_.stop(); }
+
+  void resized() override {
+    visage::Point center(width() / 2.0f, height() / 2.0f);
+    pipeline_.modify([&](Simulation& simulation) { simulation.setCenter(center); });
   }
 
   void draw(visage::Canvas& canvas) override {
+    if (pipeline_.running()) {
+      drawPipelined(canvas);
+      return;
+    }
+
     double render_time = canvas.time();
-    int render_width = width();
-    int render_height = height();
-    visage::Point center(render_width / 2.0f, render_height / 2.0f);
 
     // Calculate time delta to update particle simulation
     if (last_time_ == 0) last_time_ = render_time;
     float delta_time = static_cast<float>(render_time - last_time_);
     last_time_ = render_time;
 
-    // Emit new particles based on time passed
-    time_accumulator_ += delta_time;
-    int particles_to_emit = static_cast<int>(time_accumulator_ * kEmissionRate);
-    if (particles_to_emit > 0) {
-      time_accumulator_ -= particles_to_emit / kEmissionRate;
-      for (int i = 0; i < particles_to_emit && particles_.size() < kMaxParticles; ++i) {
-        emitParticle(center);
-      }
-    }
+    Simulation& simulation = pipeline_.simulation();
+    simulation.step(delta_time);
 
-    // Update and draw existing particles
-    for (auto it = particles_.begin(); it != particles_.end(); ) {
-      // Decrease lifetime
-      it->lifetime -= delta_time;
+    const ParticleArrays& particles = simulation.particles();
+    drawParticles(canvas, particles.x(), particles.y(), simulation.lifeRatios(), particles.tag(),
+                  particles.size());
+  }
 
-      // If particle is dead, remove it
-      if (it->lifetime <= 0) {
-        it = particles_.erase(it);
-        continue;
-      }
+  // Particles kept alive at once, up to kMaxParticles; used by the quality governor.
+  void setMaxParticles(int max_particles) {
+    pipeline_.modify([&](Simulation& simulation) { simulation.setParticleBudget(max_particles); });
+  }
 
-      // Move the particle
-      it->position += it->velocity * delta_time;
-      
-      // Update color and size based on lifetime
-      float life_ratio = it->lifetime / it->initial_lifetime; // 1.0 -> 0.0
-
-      // Fade out the particle
-      unsigned char alpha = static_cast<unsigned char>(255.0f * life_ratio);
-      it->color.setAlpha(alpha);
-      canvas.setColor(it->color);
-      
-      // Particle shrinks as it fades
-      float current_radius = kBaseParticleRadius * life_ratio;
-      canvas.circle(it->position.x - current_radius, it->position.y - current_radius, current_radius * 2.0f);
-      
-      ++it;
-    }
+  // Reseeds emission so a run can be replayed exactly.
+  void setSeed(uint64_t seed) {
+    pipeline_.modify([&](Simulation& simulation) { simulation.setSeed(seed); });
+  }
 
-    redraw(); // Keep animating
+  /**
+   * Moves the simulation onto its own fixed-timestep thread; draw() then only
+   * positions particles between the last two steps. Off by default.
+   */
+  void setPipelined(bool pipelined) {
+    pipelined_ = pipelined;
+    if (pipelined)
+      pipeline_.start();
+    else
+      pipeline_.stop();
+    last_time_ = 0;
   }
 
+  bool pipelined() const { return pipelined_; }
+  PipelineStats pipelineStats() const { return pipeline_.stats(); }
+  void setShowPipelineStats(bool show) { show_pipeline_stats_ = show; }
+
 private:
-  void emitParticle(visage::Point center) {
-    float angle = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * 6.2831853f;
-    float speed = kParticleSpeed * (0.8f + (static_cast<float>(rand()) / static_cast<float>(RAND_MAX)) * 0.4f);
-
-    Particle p;
-    p.position = center;
-    p.velocity = visage::Point(cos(angle), sin(angle)) * speed;
-    p.initial_lifetime = kParticleLifetime * (0.7f + (static_cast<float>(rand()) / static_cast<float>(RAND_MAX)) * 0.6f);
-    p.lifetime = p.initial_lifetime;
-    
-    // Pick one of the two colors randomly
-    p.color = (rand() % 2 == 0) ? kColor1 : kColor2;
+  void drawPipelined(visage::Canvas& canvas) {
+    pipeline_.beginRender();
+    float alpha = pipeline_.update();
+
+    // Swap-and-pop reorders particles between steps, so rather than pairing them up
+    // with previous() this walks each one back along its velocity from current().
+    // Motion is linear over a step, so that is the same point a lerp would give.
+    const Snapshot& snapshot = pipeline_.current();
+    int count = static_cast<int>(snapshot.x.size());
+    float rewind = (1.0f - alpha) * static_cast<float>(pipeline_.stepSeconds());
+    draw_x_.resize(count);
+    draw_y_.resize(count);
+    for (int i = 0; i < count; ++i) {
+      draw_x_[i] = snapshot.x[i] - snapshot.vx[i] * rewind;
+      draw_y_[i] = snapshot.y[i] - snapshot.vy[i] * rewind;
+    }
+
+    drawParticles(canvas, draw_x_.data(), draw_y_.data(), snapshot.life_ratio.data(),
+                  snapshot.color_index.data(), count);
+    if (show_pipeline_stats_)
+      drawPipelineStats(canvas, pipeline_.stats(), width());
+    pipeline_.endRender();
+  }
 
-    particles_.push_back(p);
+  void drawParticles(visage::Canvas& canvas, const float* xs, const float* ys, const float* life_ratios,
+                     const uint8_t* color_index, int num_particles) {
+    // Particles fade out and shrink as they age (life ratio 1.0 -> 0.0)
+    radii_.resize(num_particles);
+    for (int i = 0; i < num_particles; ++i)
+      radii_[i] = kBaseParticleRadius * life_ratios[i];
+
+    CircleInstances circles;
+    circles.x = xs;
+    circles.y = ys;
+    circles.radius = radii_.data();
+    circles.color_index = color_index;
+    circles.alpha = life_ratios;
+    circles.count = num_particles;
+    batch_.drawCircles(canvas, circles);
   }
 
-  std::vector<Particle> particles_;
+  SimulationPipeline<Simulation, Snapshot> pipeline_;
+  InstanceBatch batch_;
+  std::vector<float> radii_;
+  std::vector<float> draw_x_;
+  std::vector<float> draw_y_;
   double last_time_ = 0;
-  float time_accumulator_;
+  bool pipelined_ = false;
+  bool show_pipeline_stats_ = false;
+  ScheduledAnimation animation_{ this };
 };
 
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "visage/ui.h"
+#include "dirty_regions.h"
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <algorithm> // For std::find_if, std::remove and std::max
+
+/**
+ * @brief What the AnimationScheduler did on its most recent tick.
+ */
+struct SchedulerStats {
+    int registered = 0;       // Animations known to the scheduler
+    int ticked = 0;           // Animations redrawn on the last tick
+    int hidden = 0;           // Skipped on the last tick: hidden, off screen or inactive
+    int throttled = 0;        // Skipped on the last tick: not yet due under their frame-rate cap
+    long long frames = 0;     // Ticks that redrew at least one animation
+    long long redraws = 0;    // Animation redraws requested since start
+    double pixels = 0.0;      // Screen area redrawn on the last tick, overlaps counted once
+    double frame_interval = 0.0; // Shortest redraw interval any showing animation asks for, in seconds
+    bool idle = false;        // Nothing is animating, so no frames are being requested
+    bool suspended = false;   // suspend() is in effect
+};
+
+/**
+ * @brief Told about every AnimationScheduler tick, e.g. to draw debug output or
+ *        keep cache statistics in step with the frames being produced.
+ */
+class SchedulerListener {
+public:
+    virtual ~SchedulerListener() = default;
+    virtual void schedulerTicked(const SchedulerStats& stats) = 0;
+};
+
+/**
+ * @class AnimationScheduler
+ * @brief Drives every animated frame from one timer instead of each frame
+ *        calling redraw() at the end of its own draw().
+ *
+ * Frames register with a frame-rate cap. Each tick, a frame is redrawn only if
+ * it and all of its ancestors are visible, it overlaps the root frame, and its
+ * cap says it is due. When no registered frame is visible the scheduler drops
+ * to a slow poll that only re-checks visibility, so an idle page requests no
+ * frames at all. Call wake() after showing a frame to resume straight away.
+ *
+ * The screen rectangle of every redrawn frame goes into a DirtyRegionTracker,
+ * so the area re-rasterized per frame can be measured and shown.
+ *
+ * Animations read canvas.time() rather than counting frames, so a capped or
+ * paused animation simply jumps to the right pose on its next draw. Ones that
+ * integrate their own time step can set pause and resume callbacks, which run
+ * when the frame stops or starts being ticked, to reset their time base.
+ */
+class AnimationScheduler : public visage::EventTimer {
+public:
+    static constexpr float kDefaultFps = 60.0f;
+    static constexpr float kButtonFps = 30.0f;
+    static constexpr int kTickMs = 4;        // Faster than any cap, so caps are honoured to within a few ms
+    static constexpr int kIdlePollMs = 250;  // Visibility re-check interval while idle
+    static constexpr double kSlackSeconds = 0.002; // Ticks this early still count as due
+
+    /** @brief The scheduler shared by every animation in the app. */
+    static AnimationScheduler& shared() {
+        static AnimationScheduler scheduler;
+        return scheduler;
+    }
+
+    ~AnimationScheduler() override { stopTimer(); }
+
+    void add(visage::Frame* frame, float max_fps = kDefaultFps) {
+        if (find(frame) == animations_.end())
+            animations_.push_back({ frame, intervalFor(max_fps), 0.0, true, false, nullptr, nullptr });
+        wake();
+    }
+
+    void remove(visage::Frame* frame) {
+        auto it = find(frame);
+        if (it != animations_.end())
+            animations_.erase(it);
+    }
+
+    void setMaxFps(visage::Frame* frame, float max_fps) {
+        auto it = find(frame);
+        if (it != animations_.end())
+            it->interval = intervalFor(max_fps);
+    }
+
+    /** @brief An inactive animation keeps its registration but is never ticked. */
+    void setActive(visage::Frame* frame, bool active) {
+        auto it = find(frame);
+        if (it == animations_.end()) return;
+        it->active = active;
+        if (active)
+            wake();
+    }
+
+    /** @brief on_pause runs when the frame stops being ticked, on_resume before its first tick after. */
+    void setCallbacks(visage::Frame* frame, std::function<void()> on_pause, std::function<void()> on_resume) {
+        auto it = find(frame);
+        if (it == animations_.end()) return;
+        it->on_pause = std::move(on_pause);
+        it->on_resume = std::move(on_resume);
+    }
+
+    /** @brief Caps every animation at max_fps on top of its own cap; 0 removes the limit. */
+    void setFpsLimit(float max_fps) { limit_interval_ = intervalFor(max_fps); }
+
+    /** @brief Pauses every animation and stops the timer until resume(). */
+    void suspend() {
+        if (suspended_) return;
+        suspended_ = true;
+        for (Animation& animation : animations_)
+            pause(animation);
+        stopTimer();
+        timer_ms_ = 0;
+        stats_.ticked = 0;
+        stats_.idle = true;
+        stats_.suspended = true;
+    }
+
+    void resume() {
+        if (!suspended_) return;
+        suspended_ = false;
+        stats_.suspended = false;
+        wake();
+    }
+
+    bool suspended() const { return suspended_; }
+
+    /** @brief Leaves the idle poll and ticks at full rate again. */
+    void wake() {
+        if (!suspended_)
+            setTimerMs(kTickMs);
+    }
+
+    /** @brief Redraws every visible animation that is due. Normally called by the timer. */
+    void tick() {
+        if (suspended_) return;
+        double now = std::chrono::duration<double>(Clock::now() - epoch_).count();
+        stats_.registered = static_cast<int>(animations_.size());
+        stats_.ticked = 0;
+        stats_.hidden = 0;
+        stats_.throttled = 0;
+        stats_.frame_interval = 0.0;
+        dirty_regions_.beginFrame();
+
+        for (Animation& animation : animations_) {
+            DirtyRect rect;
+            float root_width = 0.0f;
+            float root_height = 0.0f;
+            if (!animation.active || !screenRect(animation.frame, rect, root_width, root_height)) {
+                pause(animation);
+                ++stats_.hidden;
+                continue;
+            }
+            double interval = std::max(animation.interval, limit_interval_);
+            if (stats_.frame_interval == 0.0 || interval < stats_.frame_interval)
+                stats_.frame_interval = interval;
+            if (now + kSlackSeconds < animation.next_due) {
+                ++stats_.throttled;
+                continue;
+            }
+
+            if (!animation.ticking) {
+                animation.ticking = true;
+                animation.next_due = now;
+                if (animation.on_resume)
+                    animation.on_resume();
+            }
+
+            // Keep to the cap's grid, but don't try to catch up after a stall.
+            animation.next_due = std::max(animation.next_due + interval, now);
+            animation.frame->redraw();
+            dirty_regions_.add(rect, root_width, root_height);
+            ++stats_.ticked;
+        }
+        dirty_regions_.endFrame();
+        stats_.pixels = dirty_regions_.pixels();
+
+        stats_.redraws += stats_.ticked;
+        if (stats_.ticked)
+            ++stats_.frames;
+
+        stats_.idle = stats_.ticked == 0 && stats_.throttled == 0;
+        setTimerMs(stats_.idle ? kIdlePollMs : kTickMs);
+        for (SchedulerListener* listener : listeners_)
+            listener->schedulerTicked(stats_);
+    }
+
+    void timerCallback() override { tick(); }
+
+    const SchedulerStats& stats() const { return stats_; }
+    const DirtyRegionTracker& dirtyRegions() const { return dirty_regions_; }
+
+    void addListener(SchedulerListener* listener) {
+        if (std::find(listeners_.begin(), listeners_.end(), listener) == listeners_.end())
+            listeners_.push_back(listener);
+    }
+
+    void removeListener(SchedulerListener* listener) {
+        listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), listener), listeners_.end());
+    }
+
+    /** @brief True if the frame and all its ancestors are visible and it overlaps the root. */
+    static bool isShowing(visage::Frame* frame) {
+        DirtyRect rect;
+        float root_width = 0.0f;
+        float root_height = 0.0f;
+        return screenRect(frame, rect, root_width, root_height);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Animation {
+        visage::Frame* frame;
+        double interval;  // Seconds between redraws
+        double next_due;  // Scheduler time of the next redraw
+        bool active;
+        bool ticking;     // Ticked last time it was visible; cleared when paused
+        std::function<void()> on_pause;
+        std::function<void()> on_resume;
+    };
+
+    AnimationScheduler() : epoch_(Clock::now()) {}
+
+    static void pause(Animation& animation) {
+        if (!animation.ticking) return;
+        animation.ticking = false;
+        if (animation.on_pause)
+            animation.on_pause();
+    }
+
+    static double intervalFor(float max_fps) { return max_fps > 0.0f ? 1.0 / max_fps : 0.0; }
+
+    std::vector<Animation>::iterator find(visage::Frame* frame) {
+        return std::find_if(animations_.begin(), animations_.end(),
+                            [frame](const Animation& animation) { return animation.frame == frame; });
+    }
+
+    // True if the frame is visible all the way up the tree and overlaps the root frame;
+    // rect is then its bounds in root coordinates.
+    static bool screenRect(visage::Frame* frame, DirtyRect& rect, float& root_width, float& root_height) {
+        if (frame->width() <= 0 || frame->height() <= 0)
+            return false;
+
+        float left = 0.0f;
+        float top = 0.0f;
+        visage::Frame* root = frame;
+        for (visage::Frame* f = frame; f; f = f->parent()) {
+            if (!f->isVisible())
+                return false;
+            root = f;
+            if (f->parent()) {
+                left += f->bounds().x();
+                top += f->bounds().y();
+            }
+        }
+        rect = { left, top, static_cast<float>(frame->width()), static_cast<float>(frame->height()) };
+        root_width = root->width();
+        root_height = root->height();
+        return left < root_width && top < root_height && rect.right() > 0.0f && rect.bottom() > 0.0f;
+    }
+
+    void setTimerMs(int ms) {
+        if (timer_ms_ == ms) return;
+        timer_ms_ = ms;
+        startTimer(ms);
+    }
+
+    std::vector<Animation> animations_;
+    SchedulerStats stats_;
+    DirtyRegionTracker dirty_regions_;
+    std::vector<SchedulerListener*> listeners_;
+    Clock::time_point epoch_;
+    double limit_interval_ = 0.0;
+    int timer_ms_ = 0;
+    bool suspended_ = false;
+};
+
+/**
+ * @brief Registers a frame with the shared scheduler for as long as it lives.
+ *        Declare it as the frame's last member.
+ */
+class ScheduledAnimation {
+public:
+    ScheduledAnimation(visage::Frame* frame, float max_fps = AnimationScheduler::kDefaultFps) : frame_(frame) {
+        AnimationScheduler::shared().add(frame_, max_fps);
+    }
+    ~ScheduledAnimation() { AnimationScheduler::shared().remove(frame_); }
+
+    ScheduledAnimation(const ScheduledAnimation&) = delete;
+    ScheduledAnimation& operator=(const ScheduledAnimation&) = delete;
+
+    void setMaxFps(float max_fps) { AnimationScheduler::shared().setMaxFps(frame_, max_fps); }
+    void setActive(bool active) { AnimationScheduler::shared().setActive(frame_, active); }
+    void setCallbacks(std::function<void()> on_pause, std::function<void()> on_resume) {
+        AnimationScheduler::shared().setCallbacks(frame_, std::move(on_pause), std::move(on_resume));
+    }
+
+private:
+    visage::Frame* frame_;
+};
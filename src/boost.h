@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+
+// Kernels for the travelling "boost" highlight on the animated borders. Each one is a
+// straight loop over plain float arrays with no branches or calls, so the compiler can
+// vectorize them.
+
+/**
+ * @brief Triangle-wave boost: out[i] = max(0, 1 - falloff * |params[i] - phase|).
+ */
+inline void computeBoosts(const float* params, int count, float phase, float falloff, float* out) {
+    for (int i = 0; i < count; ++i) {
+        float boost = 1.0f - falloff * std::fabs(params[i] - phase);
+        out[i] = boost > 0.0f ? boost : 0.0f;
+    }
+}
+
+/**
+ * @brief Like computeBoosts(), but the distance wraps around a closed loop so the
+ *        highlight reappears at the start when it runs off the end.
+ */
+inline void computeWrappedBoosts(const float* params, int count, float phase, float falloff, float* out) {
+    for (int i = 0; i < count; ++i) {
+        // Wrap the distance to the range [-0.5, 0.5] by subtracting the nearest whole loop.
+        // Rounding through an int conversion instead of std::floor keeps library calls out
+        // of the loop.
+        float dist = params[i] - phase;
+        float half = dist < 0.0f ? -0.5f : 0.5f;
+        dist -= static_cast<float>(static_cast<int>(dist + half));
+        float boost = 1.0f - falloff * std::fabs(dist);
+        out[i] = boost > 0.0f ? boost : 0.0f;
+    }
+}
+
+/**
+ * @brief Combines a second boost into the first: boosts[i] = max(boosts[i], other[i]).
+ */
+inline void maxBoosts(float* boosts, const float* other, int count) {
+    for (int i = 0; i < count; ++i)
+        boosts[i] = boosts[i] > other[i] ? boosts[i] : other[i];
+}
+
+/**
+ * @brief Maps boosts onto a linear range: out[i] = base + boosts[i] * scale. Used for
+ *        both stroke thicknesses and HDR multipliers.
+ */
+inline void scaleBoosts(const float* boosts, int count, float base, float scale, float* out) {
+    for (int i = 0; i < count; ++i)
+        out[i] = base + boosts[i] * scale;
+}
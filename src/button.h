@@ -5,9 +5,9 @@
 #include "visage/ui.h"
 #include <vector>
 #include <cmath>
-#include <iostream> // For console output to demonstrate event handling
 #include "embedded/shaders.h"
 #include "animated_frame.h"
+#include "shared_bloom.h"
 
 class Button : public visage::Frame {
 public:
@@ -20,13 +20,21 @@ public:
         animated->layout().setMargin(0); // Set margin to 0 for the animated frame
         animated->layout().setWidth(width_); // Set a default width for the animated frame
         animated->layout().setHeight(height_); // Set a default height for the animated frame
-        bloom_.setBloomSize(0.0f);
-        setPostEffect(&bloom_);
-
     }
 
+    // Extra glow, e.g. on hover, in the units of the shared bloom size: 0 is the resting
+    // glow and SharedBloom::kDefaultSize doubles it. No effect of its own is run.
     void set_bloom(float size) {
-        bloom_.setBloomSize(size);
+        animated->setBloomStrength(1.0f + size / SharedBloom::kDefaultSize);
+    }
+
+    void setSplineTolerance(float tolerance) { animated->setSplineTolerance(tolerance); }
+
+    void set_frames(int width_, int height_) {
+        m_width = width_;
+        m_height = height_;
+        animated->layout().setWidth(width_);
+        animated->layout().setHeight(height_);
     }
     void draw(visage::Canvas& canvas) override {
         // Example: Change color based on mouse state
@@ -44,8 +52,6 @@ public:
     // Override mouseDown to handle mouse press events
     void mouseDown(const visage::MouseEvent& e) override {
         if (e.isLeftButton()) {
-            // Corrected: Access x and y directly from e.position
-            std::cout << "Button Mouse Down at (" << e.position.x << ", " << e.position.y << ")" << std::endl;
             is_mouse_down_ = true;
             redraw(); // Request a redraw to update the button's appearance
         }
@@ -58,8 +64,6 @@ public:
         // When mouseUp is called, e.isLeftButton() will be false if the button was released.
         // The check `&& is_mouse_down_` is still important to ensure it was previously pressed on this button.
         if (!e.isLeftButton() && is_mouse_down_) {
-            // Corrected: Access x and y directly from e.position
-            std::cout << "Button Mouse Up at (" << e.position.x << ", " << e.position.y << ")" << std::endl;
             is_mouse_down_ = false;
             redraw(); // Request a redraw to update the button's appearance
         }
@@ -69,14 +73,12 @@ public:
 
     // Optional: Override mouseEnter and mouseExit for hover effects
     void mouseEnter(const visage::MouseEvent& e) override {
-        std::cout << "Mouse Entered Button" << std::endl;
         is_mouse_over_ = true;
         redraw();
         visage::Frame::mouseEnter(e);
     }
 
     void mouseExit(const visage::MouseEvent& e) override {
-        std::cout << "Mouse Exited Button" << std::endl;
         is_mouse_over_ = false;
         is_mouse_down_ = false; // Reset mouse down state if mouse exits while still down
         redraw();
@@ -90,7 +92,6 @@ public:
     int m_height = 100; // Default height
 private:
 std::unique_ptr<AnimatedFrameLeft> animated;
-visage::BloomPostEffect bloom_;
 };
 
 
@@ -105,14 +106,21 @@ public:
         animated->layout().setMargin(0); // Set margin to 0 for the animated frame
         animated->layout().setWidth(width_); // Set a default width for the animated frame
         animated->layout().setHeight(height_); // Set a default height for the animated frame
-
-        bloom_.setBloomSize(0.0f);
-        setPostEffect(&bloom_);
-
     }
 
+    // Extra glow, e.g. on hover, in the units of the shared bloom size: 0 is the resting
+    // glow and SharedBloom::kDefaultSize doubles it. No effect of its own is run.
     void set_bloom(float size) {
-        bloom_.setBloomSize(size);
+        animated->setBloomStrength(1.0f + size / SharedBloom::kDefaultSize);
+    }
+
+    void setSplineTolerance(float tolerance) { animated->setSplineTolerance(tolerance); }
+
+    void set_frames(int width_, int height_) {
+        m_width = width_;
+        m_height = height_;
+        animated->layout().setWidth(width_);
+        animated->layout().setHeight(height_);
     }
     void draw(visage::Canvas& canvas) override {
         // Example: Change color based on mouse state
@@ -130,8 +138,6 @@ public:
     // Override mouseDown to handle mouse press events
     void mouseDown(const visage::MouseEvent& e) override {
         if (e.isLeftButton()) {
-            // Corrected: Access x and y directly from e.position
-            std::cout << "Button Mouse Down at (" << e.position.x << ", " << e.position.y << ")" << std::endl;
             is_mouse_down_ = true;
             redraw(); // Request a redraw to update the button's appearance
         }
@@ -144,8 +150,6 @@ public:
         // When mouseUp is called, e.isLeftButton() will be false if the button was released.
         // The check `&& is_mouse_down_` is still important to ensure it was previously pressed on this button.
         if (!e.isLeftButton() && is_mouse_down_) {
-            // Corrected: Access x and y directly from e.position
-            std::cout << "Button Mouse Up at (" << e.position.x << ", " << e.position.y << ")" << std::endl;
             is_mouse_down_ = false;
             redraw(); // Request a redraw to update the button's appearance
         }
@@ -155,14 +159,12 @@ public:
 
     // Optional: Override mouseEnter and mouseExit for hover effects
     void mouseEnter(const visage::MouseEvent& e) override {
-        std::cout << "Mouse Entered Button" << std::endl;
         is_mouse_over_ = true;
         redraw();
         visage::Frame::mouseEnter(e);
     }
 
     void mouseExit(const visage::MouseEvent& e) override {
-        std::cout << "Mouse Exited Button" << std::endl;
         is_mouse_over_ = false;
         is_mouse_down_ = false; // Reset mouse down state if mouse exits while still down
         redraw();
@@ -176,5 +178,4 @@ public:
     int m_height = 100; // Default height
 private:
 std::unique_ptr<AnimatedFrame> animated;
-visage::BloomPostEffect bloom_;
 };
\ No newline at end of file
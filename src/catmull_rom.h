@@ -0,0 +1,229 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include <cmath>
+#include <vector>
+#include <algorithm> // For std::max and std::min
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define CATMULL_ROM_SIMD_WASM 1
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CATMULL_ROM_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CATMULL_ROM_SIMD_NEON 1
+#endif
+
+// The SIMD kernels store straight into visage::Point arrays as interleaved x/y floats.
+static_assert(sizeof(visage::Point) == 2 * sizeof(float), "visage::Point is expected to be two packed floats");
+
+/**
+ * @struct CatmullRomSpan
+ * @brief Cubic coefficients of one centripetal Catmull-Rom span.
+ *
+ * The knot spacing and tangents only depend on the four control points, so
+ * they are computed once here and every sample afterwards is a plain cubic
+ * evaluation: a * t^3 + b * t^2 + c * t + d.
+ */
+struct CatmullRomSpan {
+    float ax = 0.0f, bx = 0.0f, cx = 0.0f, dx = 0.0f;
+    float ay = 0.0f, by = 0.0f, cy = 0.0f, dy = 0.0f;
+
+    static CatmullRomSpan fromControlPoints(visage::Point p0, visage::Point p1, visage::Point p2, visage::Point p3,
+                                            float tension = 0.0f, float alpha = 0.5f) {
+        float t01 = knotDistance(p0, p1, alpha);
+        float t12 = knotDistance(p1, p2, alpha);
+        float t23 = knotDistance(p2, p3, alpha);
+
+        float inv_t01 = 1.0f / t01;
+        float inv_t23 = 1.0f / t23;
+        float inv_t01_t12 = 1.0f / (t01 + t12);
+        float inv_t12_t23 = 1.0f / (t12 + t23);
+
+        visage::Point m1 = (p2 - p1 + (p1 - p0) * inv_t01 * t12 - (p2 - p0) * inv_t01_t12 * t12) * (1.0f - tension);
+        visage::Point m2 = (p2 - p1 + (p3 - p2) * inv_t23 * t12 - (p3 - p1) * inv_t12_t23 * t12) * (1.0f - tension);
+
+        visage::Point a = (p1 - p2) * 2.0f + m1 + m2;
+        visage::Point b = (p1 - p2) * -3.0f - m1 - m1 - m2;
+
+        CatmullRomSpan span;
+        span.ax = a.x; span.bx = b.x; span.cx = m1.x; span.dx = p1.x;
+        span.ay = a.y; span.by = b.y; span.cy = m1.y; span.dy = p1.y;
+        return span;
+    }
+
+    /**
+     * @brief Smallest uniform sample count whose chords stay within tolerance of the curve.
+     *
+     * The chord error of a segment of length h is bounded by h^2 / 8 times the largest
+     * second derivative, and the second derivative of a cubic is linear in t, so its
+     * maximum sits at one of the span ends.
+     */
+    int samplesForTolerance(float tolerance, int max_samples) const {
+        if (tolerance <= 0.0f) return max_samples;
+        float end0_x = 2.0f * bx;
+        float end0_y = 2.0f * by;
+        float end1_x = 6.0f * ax + 2.0f * bx;
+        float end1_y = 6.0f * ay + 2.0f * by;
+        float curvature_sq = std::max(end0_x * end0_x + end0_y * end0_y, end1_x * end1_x + end1_y * end1_y);
+        float samples = std::ceil(std::sqrt(std::sqrt(curvature_sq) / (8.0f * tolerance)));
+        return std::max(1, std::min(max_samples, static_cast<int>(samples)));
+    }
+
+    visage::Point evaluate(float t) const {
+        return visage::Point(((ax * t + bx) * t + cx) * t + dx, ((ay * t + by) * t + cy) * t + dy);
+    }
+
+    /**
+     * @brief Writes num_samples points at t = j / num_samples for j in [0, num_samples).
+     */
+    void sample(int num_samples, visage::Point* out) const {
+        if (num_samples <= 0) return;
+        float step = 1.0f / num_samples;
+        int j = 0;
+#if defined(CATMULL_ROM_SIMD_SSE) || defined(CATMULL_ROM_SIMD_WASM) || defined(CATMULL_ROM_SIMD_NEON)
+        j = sampleSimd(num_samples, step, out);
+#endif
+        sampleForwardDifference(j, num_samples, step, out);
+    }
+
+private:
+    static float knotDistance(visage::Point a, visage::Point b, float alpha) {
+        visage::Point delta = b - a;
+        float distance_sq = delta.x * delta.x + delta.y * delta.y;
+        // Centripetal (alpha = 0.5) is distance^0.5, which is a double square root of distance^2.
+        float knot = alpha == 0.5f ? std::sqrt(std::sqrt(distance_sq)) : std::pow(distance_sq, 0.5f * alpha);
+        return knot < 1e-6f ? 1.0f : knot;
+    }
+
+    // Forward differencing: three additions per sample once the differences are seeded.
+    // Drift is negligible for the few dozen steps a span takes, and the seed is re-evaluated
+    // exactly at `start` so this can pick up wherever the SIMD kernel stopped.
+    void sampleForwardDifference(int start, int num_samples, float step, visage::Point* out) const {
+        if (start >= num_samples) return;
+        float h = step;
+        float h2 = h * h;
+        float h3 = h2 * h;
+        float t = start * step;
+
+        visage::Point value = evaluate(t);
+        // First, second and third differences of the cubic at t.
+        float d1x = ax * (3.0f * t * t * h + 3.0f * t * h2 + h3) + bx * (2.0f * t * h + h2) + cx * h;
+        float d1y = ay * (3.0f * t * t * h + 3.0f * t * h2 + h3) + by * (2.0f * t * h + h2) + cy * h;
+        float d2x = ax * (6.0f * t * h2 + 6.0f * h3) + bx * 2.0f * h2;
+        float d2y = ay * (6.0f * t * h2 + 6.0f * h3) + by * 2.0f * h2;
+        float d3x = ax * 6.0f * h3;
+        float d3y = ay * 6.0f * h3;
+
+        for (int j = start; j < num_samples; ++j) {
+            out[j] = value;
+            value.x += d1x; value.y += d1y;
+            d1x += d2x; d1y += d2y;
+            d2x += d3x; d2y += d3y;
+        }
+    }
+
+#if defined(CATMULL_ROM_SIMD_SSE)
+    // Four samples per iteration with Horner's rule; returns how many samples were written.
+    int sampleSimd(int num_samples, float step, visage::Point* out) const {
+        __m128 a_x = _mm_set1_ps(ax), b_x = _mm_set1_ps(bx), c_x = _mm_set1_ps(cx), d_x = _mm_set1_ps(dx);
+        __m128 a_y = _mm_set1_ps(ay), b_y = _mm_set1_ps(by), c_y = _mm_set1_ps(cy), d_y = _mm_set1_ps(dy);
+        __m128 t = _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(step));
+        __m128 t_step = _mm_set1_ps(4.0f * step);
+        float* destination = reinterpret_cast<float*>(out);
+
+        int j = 0;
+        for (; j + 4 <= num_samples; j += 4) {
+            __m128 x = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a_x, t), b_x), t), c_x), t), d_x);
+            __m128 y = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a_y, t), b_y), t), c_y), t), d_y);
+            _mm_storeu_ps(destination + 2 * j, _mm_unpacklo_ps(x, y));
+            _mm_storeu_ps(destination + 2 * j + 4, _mm_unpackhi_ps(x, y));
+            t = _mm_add_ps(t, t_step);
+        }
+        return j;
+    }
+#elif defined(CATMULL_ROM_SIMD_WASM)
+    int sampleSimd(int num_samples, float step, visage::Point* out) const {
+        v128_t a_x = wasm_f32x4_splat(ax), b_x = wasm_f32x4_splat(bx), c_x = wasm_f32x4_splat(cx), d_x = wasm_f32x4_splat(dx);
+        v128_t a_y = wasm_f32x4_splat(ay), b_y = wasm_f32x4_splat(by), c_y = wasm_f32x4_splat(cy), d_y = wasm_f32x4_splat(dy);
+        v128_t t = wasm_f32x4_mul(wasm_f32x4_make(0.0f, 1.0f, 2.0f, 3.0f), wasm_f32x4_splat(step));
+        v128_t t_step = wasm_f32x4_splat(4.0f * step);
+        float* destination = reinterpret_cast<float*>(out);
+
+        int j = 0;
+        for (; j + 4 <= num_samples; j += 4) {
+            v128_t x = wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_add(wasm_f32x4_mul(a_x, t), b_x), t), c_x), t), d_x);
+            v128_t y = wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_add(wasm_f32x4_mul(a_y, t), b_y), t), c_y), t), d_y);
+            wasm_v128_store(destination + 2 * j, wasm_i32x4_shuffle(x, y, 0, 4, 1, 5));
+            wasm_v128_store(destination + 2 * j + 4, wasm_i32x4_shuffle(x, y, 2, 6, 3, 7));
+            t = wasm_f32x4_add(t, t_step);
+        }
+        return j;
+    }
+#elif defined(CATMULL_ROM_SIMD_NEON)
+    int sampleSimd(int num_samples, float step, visage::Point* out) const {
+        float32x4_t a_x = vdupq_n_f32(ax), b_x = vdupq_n_f32(bx), c_x = vdupq_n_f32(cx), d_x = vdupq_n_f32(dx);
+        float32x4_t a_y = vdupq_n_f32(ay), b_y = vdupq_n_f32(by), c_y = vdupq_n_f32(cy), d_y = vdupq_n_f32(dy);
+        const float offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        float32x4_t t = vmulq_n_f32(vld1q_f32(offsets), step);
+        float32x4_t t_step = vdupq_n_f32(4.0f * step);
+        float* destination = reinterpret_cast<float*>(out);
+
+        int j = 0;
+        for (; j + 4 <= num_samples; j += 4) {
+            float32x4x2_t xy;
+            xy.val[0] = vmlaq_f32(d_x, vmlaq_f32(c_x, vmlaq_f32(b_x, a_x, t), t), t);
+            xy.val[1] = vmlaq_f32(d_y, vmlaq_f32(c_y, vmlaq_f32(b_y, a_y, t), t), t);
+            vst2q_f32(destination + 2 * j, xy);
+            t = vaddq_f32(t, t_step);
+        }
+        return j;
+    }
+#endif
+};
+
+/**
+ * @brief Samples a closed Catmull-Rom loop.
+ * @param control_points num_spans + 3 points, with the first three repeated at the end.
+ * @param out Receives num_spans * samples_per_span points. Sample k lies on span
+ *            k / samples_per_span at t = (k % samples_per_span) / samples_per_span,
+ *            so out[0] is control_points[1] and the loop closes back onto it.
+ */
+inline void sampleClosedCatmullRom(const visage::Point* control_points, int num_spans, int samples_per_span,
+                                   visage::Point* out) {
+    for (int i = 0; i < num_spans; ++i) {
+        CatmullRomSpan span = CatmullRomSpan::fromControlPoints(control_points[i], control_points[i + 1],
+                                                                control_points[i + 2], control_points[i + 3]);
+        span.sample(samples_per_span, out + i * samples_per_span);
+    }
+}
+
+/**
+ * @brief Samples a closed Catmull-Rom loop, choosing each span's sample count from a
+ *        screen-space flatness tolerance (in pixels) instead of a fixed count.
+ * @param params If non-null, receives each sample's position around the loop in [0, 1).
+ * @return The number of samples written, which is also the number of stroke segments.
+ */
+inline int sampleClosedCatmullRomAdaptive(const visage::Point* control_points, int num_spans, float tolerance,
+                                          int max_samples_per_span, std::vector<visage::Point>& out,
+                                          std::vector<float>* params = nullptr) {
+    out.clear();
+    if (params) params->clear();
+
+    for (int i = 0; i < num_spans; ++i) {
+        CatmullRomSpan span = CatmullRomSpan::fromControlPoints(control_points[i], control_points[i + 1],
+                                                                control_points[i + 2], control_points[i + 3]);
+        int num_samples = span.samplesForTolerance(tolerance, max_samples_per_span);
+        size_t start = out.size();
+        out.resize(start + num_samples);
+        span.sample(num_samples, out.data() + start);
+
+        if (params) {
+            for (int j = 0; j < num_samples; ++j)
+                params->push_back((i + static_cast<float>(j) / num_samples) / num_spans);
+        }
+    }
+    return static_cast<int>(out.size());
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include "visage/ui.h"
+#include "embedded/fonts.h"
+#include "animation_scheduler.h"
+#include "layer_cache.h"
+#include "font_cache.h"
+#include "quality_governor.h"
+#include "proportional_layout.h"
+#include <cstdio>
+
+/**
+ * @class RedrawRegionOverlay
+ * @brief Debug overlay that tints the regions redrawn on the last scheduler tick
+ *        and prints the pixel count, layer and font cache use and, when given them,
+ *        the quality level and layout timing. Add it as the root's last child, full size.
+ *
+ * While enabled it redraws itself after every tick that redrew anything, so it
+ * costs a full-canvas composite of its own; leave it off outside debugging.
+ */
+class RedrawRegionOverlay : public visage::Frame, public SchedulerListener {
+public:
+    static constexpr unsigned int kFillColor = 0x30ff3030;
+    static constexpr unsigned int kOutlineColor = 0xffff3030;
+
+    RedrawRegionOverlay() {
+        setIgnoresMouseEvents(true, false);
+        setVisible(false);
+    }
+
+    ~RedrawRegionOverlay() override { setEnabled(false); }
+
+    void setEnabled(bool enabled) {
+        AnimationScheduler& scheduler = AnimationScheduler::shared();
+        if (enabled)
+            scheduler.addListener(this);
+        else
+            scheduler.removeListener(this);
+        enabled_ = enabled;
+        setVisible(enabled);
+        redraw();
+    }
+
+    bool enabled() const { return enabled_; }
+
+    void setQualityGovernor(const QualityGovernor* governor) { governor_ = governor; }
+    void setLayout(const ProportionalLayout* layout) { layout_ = layout; }
+
+    void schedulerTicked(const SchedulerStats& stats) override {
+        if (stats.ticked)
+            redraw();
+    }
+
+    void draw(visage::Canvas& canvas) override {
+        const AnimationScheduler& scheduler = AnimationScheduler::shared();
+        const DirtyRegionTracker& regions = scheduler.dirtyRegions();
+
+        for (const DirtyRect& region : regions.regions()) {
+            canvas.setColor(kFillColor);
+            canvas.rectangle(region.x, region.y, region.width, region.height);
+            canvas.setColor(kOutlineColor);
+            canvas.rectangle(region.x, region.y, region.width, 1.0f);
+            canvas.rectangle(region.x, region.bottom() - 1.0f, region.width, 1.0f);
+            canvas.rectangle(region.x, region.y, 1.0f, region.height);
+            canvas.rectangle(region.right() - 1.0f, region.y, 1.0f, region.height);
+        }
+
+        char line[128];
+        std::snprintf(line, sizeof(line), "%d animations  %d regions  %.0f px redrawn (%.1f%%)",
+                      scheduler.stats().ticked, static_cast<int>(regions.regions().size()), regions.pixels(),
+                      100.0 * regions.coverage());
+        const visage::Font& font = FontCache::shared().get(12);
+        canvas.setColor(0xffffffff);
+        canvas.text(line, font, visage::Font::Justification::kTopLeft, 4.0f, height() - 68.0f, width() - 8.0f, 16.0f);
+
+        LayerCacheStats layers = LayerCache::shared().stats();
+        std::snprintf(line, sizeof(line), "%d cached layers  %.1f%% hits  %.1f MB textures", layers.layers,
+                      100.0 * layers.hitRate(), layers.texture_bytes / (1024.0 * 1024.0));
+        canvas.text(line, font, visage::Font::Justification::kTopLeft, 4.0f, height() - 52.0f, width() - 8.0f, 16.0f);
+
+        FontCacheStats fonts = FontCache::shared().stats();
+        std::snprintf(line, sizeof(line), "%d fonts  %.1f%% hits  %lld misses  %.0f KB atlases", fonts.fonts,
+                      100.0 * fonts.hitRate(), fonts.misses, fonts.atlas_bytes / 1024.0);
+        canvas.text(line, font, visage::Font::Justification::kTopLeft, 4.0f, height() - 36.0f, width() - 8.0f, 16.0f);
+
+        if (governor_) {
+            std::snprintf(line, sizeof(line), "quality %d/%d  %.1f ms/frame  %.0f%% load  %d changes",
+                          governor_->level(), QualityGovernor::kMaxLevel, governor_->frameMs(),
+                          100.0 * governor_->load(), static_cast<int>(governor_->log().size()));
+            canvas.text(line, font, visage::Font::Justification::kTopLeft, 4.0f, height() - 20.0f, width() - 8.0f, 16.0f);
+        }
+
+        if (layout_) {
+            const LayoutStats& stats = layout_->stats();
+            std::snprintf(line, sizeof(line), "layout %d nodes  %d recomputed  %.3f ms last  %lld relayouts",
+                          stats.nodes, stats.recomputed, stats.last_ms, stats.updates);
+            canvas.text(line, font, visage::Font::Justification::kTopLeft, 4.0f, height() - 84.0f, width() - 8.0f, 16.0f);
+        }
+    }
+
+private:
+    const QualityGovernor* governor_ = nullptr;
+    const ProportionalLayout* layout_ = nullptr;
+    bool enabled_ = false;
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <vector>
+#include <algorithm> // For std::min/max and std::sort
+
+/**
+ * @brief An axis-aligned rectangle in root-frame pixels.
+ */
+struct DirtyRect {
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+
+    float right() const { return x + width; }
+    float bottom() const { return y + height; }
+    double area() const { return static_cast<double>(width) * height; }
+
+    bool touches(const DirtyRect& other) const {
+        return x <= other.right() && other.x <= right() && y <= other.bottom() && other.y <= bottom();
+    }
+
+    DirtyRect united(const DirtyRect& other) const {
+        float left = std::min(x, other.x);
+        float top = std::min(y, other.y);
+        return { left, top, std::max(right(), other.right()) - left, std::max(bottom(), other.bottom()) - top };
+    }
+};
+
+/**
+ * @class DirtyRegionTracker
+ * @brief Collects the screen rectangles redrawn in one frame.
+ *
+ * Rectangles are clipped to the root. Two are merged into their bounding box
+ * only when that box is no larger than the two areas together, i.e. when they
+ * overlap heavily, so separate strips such as a border's edges stay separate
+ * regions. pixels() is the exact area of their union, each pixel counted once:
+ * the area visage had to re-rasterize and composite for the frame.
+ */
+class DirtyRegionTracker {
+public:
+    void beginFrame() {
+        regions_.clear();
+        pixels_ = 0.0;
+    }
+
+    /** @brief Adds rect, clipped to a root of the given size. */
+    void add(DirtyRect rect, float root_width, float root_height) {
+        root_width_ = root_width;
+        root_height_ = root_height;
+        float left = std::max(rect.x, 0.0f);
+        float top = std::max(rect.y, 0.0f);
+        float right = std::min(rect.right(), root_width_);
+        float bottom = std::min(rect.bottom(), root_height_);
+        if (right <= left || bottom <= top) return;
+        regions_.push_back({ left, top, right - left, bottom - top });
+    }
+
+    /** @brief Merges rectangles where that costs no extra area and totals the area. */
+    void endFrame() {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t i = 0; i < regions_.size() && !merged; ++i) {
+                for (size_t j = i + 1; j < regions_.size(); ++j) {
+                    DirtyRect united = regions_[i].united(regions_[j]);
+                    if (regions_[i].touches(regions_[j]) && united.area() <= regions_[i].area() + regions_[j].area()) {
+                        regions_[i] = united;
+                        regions_.erase(regions_.begin() + j);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        pixels_ = unionArea();
+    }
+
+    const std::vector<DirtyRect>& regions() const { return regions_; }
+    double pixels() const { return pixels_; }
+
+    /** @brief Fraction of the root redrawn, from 0 to 1. */
+    double coverage() const {
+        double total = static_cast<double>(root_width_) * root_height_;
+        return total > 0.0 ? pixels_ / total : 0.0;
+    }
+
+private:
+    // Area covered by the regions, overlaps once: sweep the x intervals between edges and
+    // total the y extent covered in each. Fine for the handful of regions in a frame.
+    double unionArea() {
+        xs_.clear();
+        for (const DirtyRect& region : regions_) {
+            xs_.push_back(region.x);
+            xs_.push_back(region.right());
+        }
+        std::sort(xs_.begin(), xs_.end());
+
+        double area = 0.0;
+        for (size_t i = 0; i + 1 < xs_.size(); ++i) {
+            float left = xs_[i];
+            float right = xs_[i + 1];
+            if (right <= left) continue;
+            spans_.clear();
+            for (const DirtyRect& region : regions_) {
+                if (region.x <= left && region.right() >= right)
+                    spans_.push_back({ region.y, region.bottom() });
+            }
+            std::sort(spans_.begin(), spans_.end());
+            float covered = 0.0f;
+            float end = -1.0f;
+            for (const Span& span : spans_) {
+                float start = std::max(span.start, end);
+                if (span.end > start)
+                    covered += span.end - start;
+                end = std::max(end, span.end);
+            }
+            area += static_cast<double>(right - left) * covered;
+        }
+        return area;
+    }
+
+    struct Span {
+        float start;
+        float end;
+        bool operator<(const Span& other) const { return start < other.start; }
+    };
+
+    std::vector<DirtyRect> regions_;
+    std::vector<float> xs_;
+    std::vector<Span> spans_;
+    double pixels_ = 0.0;
+    float root_width_ = 0.0f;
+    float root_height_ = 0.0f;
+};
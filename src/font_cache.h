@@ -0,0 +1,99 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include "embedded/fonts.h"
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <algorithm> // For std::max
+
+/**
+ * @brief Totals for the shared FontCache.
+ */
+struct FontCacheStats {
+    int fonts = 0;              // Distinct (typeface, pixel size) entries
+    long long hits = 0;         // Lookups served by an existing font
+    long long misses = 0;       // Lookups that had to create one
+    size_t atlas_bytes = 0;     // Estimated glyph atlas memory held alive by the cache
+
+    double hitRate() const {
+        long long lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+    }
+};
+
+/**
+ * @class FontCache
+ * @brief One visage::Font per (typeface, pixel size), shared by every frame.
+ *
+ * Building a Font looks up its packed glyph atlas, and destroying the last Font
+ * at a size lets the atlas go, so fonts made on the stack in a draw callback
+ * can re-rasterize their glyphs every frame. get() returns a reference to a
+ * font the cache keeps alive instead; after the first call at a size it is a
+ * single hash lookup. Sizes are rounded to whole pixels, which is what the
+ * callers already did, so neighbouring layout sizes share an entry.
+ */
+class FontCache {
+public:
+    static constexpr int kEstimatedGlyphs = 96;   // Printable ASCII, which is all the app draws
+    static constexpr int kGlyphPadding = 2;       // Atlas padding around each glyph, in pixels
+
+    static FontCache& shared() {
+        static FontCache cache;
+        return cache;
+    }
+
+    FontCache(const FontCache&) = delete;
+    FontCache& operator=(const FontCache&) = delete;
+
+    const visage::Font& get(float size, const visage::EmbeddedFile& typeface = visage::fonts::Lato_Regular_ttf) {
+        Key key { typeface.data, std::max(1, static_cast<int>(size)) };
+        auto found = fonts_.find(key);
+        if (found != fonts_.end()) {
+            ++hits_;
+            return found->second;
+        }
+
+        ++misses_;
+        return fonts_.emplace(key, visage::Font(static_cast<float>(key.pixels), typeface)).first->second;
+    }
+
+    /** @brief Drops every font; references from get() are invalid afterwards. */
+    void clear() { fonts_.clear(); }
+
+    FontCacheStats stats() const {
+        FontCacheStats stats;
+        stats.fonts = static_cast<int>(fonts_.size());
+        stats.hits = hits_;
+        stats.misses = misses_;
+        for (const auto& entry : fonts_)
+            stats.atlas_bytes += atlasBytes(entry.first.pixels);
+        return stats;
+    }
+
+    /** @brief Estimated single-channel atlas size for a font of the given pixel size. */
+    static size_t atlasBytes(int pixels) {
+        size_t cell = static_cast<size_t>(pixels + 2 * kGlyphPadding);
+        return cell * cell * kEstimatedGlyphs;
+    }
+
+private:
+    struct Key {
+        const char* typeface;
+        int pixels;
+
+        bool operator==(const Key& other) const { return typeface == other.typeface && pixels == other.pixels; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<const char*>()(key.typeface) ^ (std::hash<int>()(key.pixels) << 1);
+        }
+    };
+
+    FontCache() = default;
+
+    std::unordered_map<Key, visage::Font, KeyHash> fonts_;
+    long long hits_ = 0;
+    long long misses_ = 0;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include "stroke.h"
+#include "catmull_rom.h"
+#include "boost.h"
+#include <vector>
+
+/**
+ * @class StrokeGeometryCache
+ * @brief Holds tessellated stroke geometry that only depends on a frame's size.
+ *
+ * The owning frame calls invalidate() from resized() and rebuilds in draw()
+ * when needsRebuild() says the cached size no longer matches. In between,
+ * per-frame work is limited to StrokeMesh::setThicknesses() and colours.
+ */
+class StrokeGeometryCache {
+public:
+    bool needsRebuild(int width, int height) const {
+        return width != width_ || height != height_;
+    }
+
+    void invalidate() {
+        width_ = -1;
+        height_ = -1;
+    }
+
+    void markBuilt(int width, int height) {
+        width_ = width;
+        height_ = height;
+        ++num_rebuilds_;
+    }
+
+    StrokeMesh& mesh() { return mesh_; }
+    const StrokeMesh& mesh() const { return mesh_; }
+
+    // Sample positions the mesh was built from, and each sample's position along the stroke.
+    std::vector<visage::Point>& points() { return points_; }
+    std::vector<float>& params() { return params_; }
+
+    int numRebuilds() const { return num_rebuilds_; }
+
+private:
+    StrokeMesh mesh_;
+    std::vector<visage::Point> points_;
+    std::vector<float> params_;
+    int width_ = -1;
+    int height_ = -1;
+    int num_rebuilds_ = 0;
+};
+
+/**
+ * @class BoostedSplineStroke
+ * @brief Samples closed Catmull-Rom loops and draws them as strokes whose width
+ *        and HDR follow a travelling boost, reusing its scratch buffers.
+ *
+ * Shared by the button line animations: sample() fills the points a mesh is
+ * built from, draw() sets the mesh's thicknesses and draws it every frame.
+ */
+class BoostedSplineStroke {
+public:
+    explicit BoostedSplineStroke(float tolerance) : tolerance_(tolerance) {}
+
+    // Maximum distance in pixels between the sampled polyline and the true spline;
+    // zero samples every span at the fixed max_samples_per_span.
+    void setTolerance(float tolerance) { tolerance_ = tolerance; }
+    float tolerance() const { return tolerance_; }
+
+    // Stroke segments drawn since the last resetEmittedSegments().
+    int emittedSegments() const { return emitted_segments_; }
+    void resetEmittedSegments() { emitted_segments_ = 0; }
+
+    /**
+     * Samples a closed Catmull-Rom loop into points plus each point's loop_t in
+     * [0, 1). With a positive tolerance each span gets only as many samples as
+     * its curvature needs, capped at max_samples_per_span.
+     */
+    int sample(const std::vector<visage::Point>& control_points, int num_spans, int max_samples_per_span,
+               std::vector<visage::Point>& points, std::vector<float>& params) const {
+        int num_samples = 0;
+        if (tolerance_ > 0.0f) {
+            num_samples = sampleClosedCatmullRomAdaptive(control_points.data(), num_spans, tolerance_,
+                                                         max_samples_per_span, points, &params);
+        }
+        else {
+            num_samples = num_spans * max_samples_per_span;
+            points.resize(num_samples);
+            params.resize(num_samples);
+            sampleClosedCatmullRom(control_points.data(), num_spans, max_samples_per_span, points.data());
+            for (int k = 0; k < num_samples; ++k)
+                params[k] = static_cast<float>(k) / num_samples;
+        }
+        return num_samples;
+    }
+
+    /**
+     * Draws a closed stroke whose width and HDR follow a triangle-wave boost
+     * centred on boost_phase. params holds one loop_t per mesh point.
+     */
+    void draw(visage::Canvas& canvas, StrokeMesh& mesh, const std::vector<float>& params,
+              visage::Color base_color, float base_thickness, float thickness_boost,
+              float intensity_multiplier, float boost_phase, float boost_falloff) {
+        int num_samples = mesh.numPoints();
+        emitted_segments_ += mesh.numSegments();
+
+        boosts_.resize(num_samples);
+        thicknesses_.resize(num_samples);
+        hdr_.resize(num_samples);
+        computeBoosts(params.data(), num_samples, boost_phase, boost_falloff, boosts_.data());
+        scaleBoosts(boosts_.data(), num_samples, base_thickness, thickness_boost, thicknesses_.data());
+        scaleBoosts(boosts_.data(), num_samples, 1.0f, intensity_multiplier, hdr_.data());
+
+        mesh.setThicknesses(thicknesses_.data());
+        mesh.drawHdr(canvas, base_color, hdr_.data());
+    }
+
+private:
+    std::vector<float> boosts_;
+    std::vector<float> thicknesses_;
+    std::vector<float> hdr_;
+    float tolerance_ = 0.0f;
+    int emitted_segments_ = 0;
+};
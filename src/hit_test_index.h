@@ -0,0 +1,96 @@
+#pragma once
+
+#include "proportional_layout.h" // For LayoutBox
+#include <vector>
+#include <cmath>
+#include <algorithm> // For std::min/max
+
+/**
+ * @class HitTestIndex
+ * @brief Finds the topmost rectangle under a point without testing them all.
+ *
+ * Rectangles are given in root pixels with an id, in back-to-front order.
+ * build() buckets each one into every grid cell it overlaps, so hitTest()
+ * only looks at the few rectangles in the cell under the point. Rebuild
+ * after layout changes; queries in between cost the same however many
+ * rectangles there are, as long as they are spread over the grid.
+ */
+class HitTestIndex {
+public:
+    static constexpr float kDefaultCellSize = 64.0f;
+
+    void clear() {
+        entries_.clear();
+        cell_start_.assign(1, 0);
+        cell_entries_.clear();
+        columns_ = 0;
+        rows_ = 0;
+    }
+
+    /** @brief Adds a rectangle above everything added before it; takes effect at the next build(). */
+    void add(int id, const LayoutBox& box) { entries_.push_back({ id, box }); }
+
+    void build(float width, float height, float cell_size = kDefaultCellSize) {
+        cell_size_ = std::max(cell_size, 1.0f);
+        columns_ = std::max(1, static_cast<int>(std::ceil(width / cell_size_)));
+        rows_ = std::max(1, static_cast<int>(std::ceil(height / cell_size_)));
+
+        // Two passes: count the entries per cell, then fill them in, keeping each cell's
+        // entries in insertion order so the last match is the topmost.
+        int num_cells = columns_ * rows_;
+        cell_start_.assign(num_cells + 1, 0);
+        forEachCell([&](int cell, int) { ++cell_start_[cell + 1]; });
+        for (int cell = 0; cell < num_cells; ++cell)
+            cell_start_[cell + 1] += cell_start_[cell];
+
+        cell_entries_.resize(cell_start_[num_cells]);
+        std::vector<int> fill(cell_start_.begin(), cell_start_.end() - 1);
+        forEachCell([&](int cell, int entry) { cell_entries_[fill[cell]++] = entry; });
+    }
+
+    /** @brief The id of the topmost rectangle strictly containing (x, y), or -1. */
+    int hitTest(float x, float y) const {
+        if (columns_ == 0 || x < 0.0f || y < 0.0f) return -1;
+        int column = static_cast<int>(x / cell_size_);
+        int row = static_cast<int>(y / cell_size_);
+        if (column >= columns_ || row >= rows_) return -1;
+
+        int cell = row * columns_ + column;
+        for (int i = cell_start_[cell + 1] - 1; i >= cell_start_[cell]; --i) {
+            const LayoutBox& box = entries_[cell_entries_[i]].box;
+            if (x > box.x && x < box.x + box.width && y > box.y && y < box.y + box.height)
+                return entries_[cell_entries_[i]].id;
+        }
+        return -1;
+    }
+
+    int size() const { return static_cast<int>(entries_.size()); }
+
+private:
+    struct Entry {
+        int id;
+        LayoutBox box;
+    };
+
+    template <typename Function>
+    void forEachCell(Function function) const {
+        for (int entry = 0; entry < static_cast<int>(entries_.size()); ++entry) {
+            const LayoutBox& box = entries_[entry].box;
+            int first_column = std::max(0, static_cast<int>(box.x / cell_size_));
+            int last_column = std::min(columns_ - 1, static_cast<int>((box.x + box.width) / cell_size_));
+            int first_row = std::max(0, static_cast<int>(box.y / cell_size_));
+            int last_row = std::min(rows_ - 1, static_cast<int>((box.y + box.height) / cell_size_));
+            for (int row = first_row; row <= last_row; ++row) {
+                for (int column = first_column; column <= last_column; ++column)
+                    function(row * columns_ + column, entry);
+            }
+        }
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<int> cell_start_ = std::vector<int>(1, 0);
+    std::vector<int> cell_entries_;
+    float cell_size_ = kDefaultCellSize;
+    int columns_ = 0;
+    int rows_ = 0;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "visage/ui.h"
+#include "animation_scheduler.h"
+#include <chrono>
+#include <functional>
+
+/**
+ * @brief Reports whether the page is currently visible. The browser build reads
+ *        the document's visibility state; other builds can plug in their own.
+ */
+class VisibilitySource {
+public:
+    virtual ~VisibilitySource() = default;
+    virtual bool pageVisible() const = 0;
+};
+
+enum class IdleState {
+    kActive,    // Animations run at their own caps
+    kLowPower,  // Nobody has interacted for a while; every animation is capped at the low-power rate
+    kSuspended  // The page is hidden; nothing is ticked at all
+};
+
+/**
+ * @class IdleMonitor
+ * @brief Moves an AnimationScheduler between full rate, a low-power rate and
+ *        fully suspended, from page visibility and time since the last input.
+ *
+ * Call noteActivity() on user input and update() whenever visibility may have
+ * changed; the monitor's own timer also calls update() once a second to catch
+ * the inactivity timeout. Resuming goes through the scheduler, so frames that
+ * integrate their own time step restart from a fresh time base instead of
+ * seeing the whole hidden period as one step.
+ */
+class IdleMonitor : public visage::EventTimer {
+public:
+    static constexpr double kDefaultInactivitySeconds = 120.0;
+    static constexpr float kDefaultLowPowerFps = 10.0f;
+    static constexpr int kPollMs = 1000;
+
+    IdleMonitor(VisibilitySource& visibility, AnimationScheduler& scheduler = AnimationScheduler::shared())
+        : visibility_(visibility), scheduler_(scheduler), epoch_(Clock::now()) {}
+
+    ~IdleMonitor() override { stopTimer(); }
+
+    /** @brief Seconds without input before dropping to low power; 0 never does. */
+    void setInactivityTimeout(double seconds) { inactivity_seconds_ = seconds; }
+    void setLowPowerFps(float fps) { low_power_fps_ = fps; }
+
+    void start() {
+        last_activity_ = now();
+        update();
+        startTimer(kPollMs);
+    }
+
+    void noteActivity() { noteActivity(now()); }
+    void noteActivity(double time) {
+        last_activity_ = time;
+        if (state_ == IdleState::kLowPower)
+            update(time);
+    }
+
+    IdleState update() { return update(now()); }
+
+    /** @brief Re-evaluates the state at the given monitor time in seconds. */
+    IdleState update(double time) {
+        IdleState state = IdleState::kActive;
+        bool visible = visibility_.pageVisible();
+        // Coming back to a hidden page counts as activity, however long it was away.
+        if (visible && state_ == IdleState::kSuspended)
+            last_activity_ = time;
+        if (!visible)
+            state = IdleState::kSuspended;
+        else if (inactivity_seconds_ > 0.0 && time - last_activity_ >= inactivity_seconds_)
+            state = IdleState::kLowPower;
+
+        if (state != state_) {
+            state_ = state;
+            apply();
+            if (on_state_changed_)
+                on_state_changed_(state_);
+        }
+        return state_;
+    }
+
+    void timerCallback() override { update(); }
+
+    IdleState state() const { return state_; }
+
+    /** @brief Called after every state change, e.g. to pause the host's main loop. */
+    std::function<void(IdleState)>& onStateChanged() { return on_state_changed_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double now() const { return std::chrono::duration<double>(Clock::now() - epoch_).count(); }
+
+    void apply() {
+        switch (state_) {
+        case IdleState::kActive:
+            scheduler_.setFpsLimit(0.0f);
+            scheduler_.resume();
+            scheduler_.wake();
+            break;
+        case IdleState::kLowPower:
+            scheduler_.setFpsLimit(low_power_fps_);
+            scheduler_.resume();
+            break;
+        case IdleState::kSuspended:
+            scheduler_.suspend();
+            break;
+        }
+    }
+
+    VisibilitySource& visibility_;
+    AnimationScheduler& scheduler_;
+    Clock::time_point epoch_;
+    std::function<void(IdleState)> on_state_changed_;
+    IdleState state_ = IdleState::kActive;
+    double last_activity_ = 0.0;
+    double inactivity_seconds_ = kDefaultInactivitySeconds;
+    float low_power_fps_ = kDefaultLowPowerFps;
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm> // For std::min/max
+
+/**
+ * @brief Structure-of-arrays description of many circles. Every pointer except
+ *        x and y may be null, in which case the single fallback value is used.
+ */
+struct CircleInstances {
+    const float* x = nullptr;            // Centres
+    const float* y = nullptr;
+    const float* radius = nullptr;       // Per-circle radius, or the constant below
+    float constant_radius = 1.0f;
+    const uint8_t* color_index = nullptr; // Index into the batch palette, or 0
+    const float* alpha = nullptr;        // 0..1 opacity, or the palette colour's own
+    const float* hdr = nullptr;          // HDR multiplier, or 1
+    int count = 0;
+};
+
+/**
+ * @brief Structure-of-arrays description of many straight line quads.
+ */
+struct LineInstances {
+    const float* x1 = nullptr;
+    const float* y1 = nullptr;
+    const float* x2 = nullptr;
+    const float* y2 = nullptr;
+    float thickness = 1.0f;
+    const uint8_t* color_index = nullptr; // Index into the batch palette, or 0
+    const float* alpha = nullptr;         // 0..1 opacity, or the palette colour's own
+    int count = 0;
+};
+
+/**
+ * @class InstanceBatch
+ * @brief Draws large numbers of circles or line quads from flat arrays.
+ *
+ * visage has no public instanced draw, but it merges consecutive shapes of the
+ * same kind and colour into one batch. InstanceBatch takes every instance's
+ * colour as a palette index plus quantized alpha and HDR levels and
+ * counting-sorts the instances by that key. Each key is then one contiguous run
+ * behind a single setColor, so the per-instance cost is an array read and a
+ * shape call, and the number of colour changes is bounded by the palette size
+ * times kLevels^2 rather than by the instance count.
+ */
+class InstanceBatch {
+public:
+    static constexpr int kMaxPaletteSize = 8;
+    static constexpr int kLevels = 32;
+
+    void setPalette(const visage::Color* colors, int count) {
+        palette_.assign(colors, colors + std::min(count, kMaxPaletteSize));
+    }
+
+    void setPalette(visage::Color color) { palette_.assign(1, color); }
+
+    void drawCircles(visage::Canvas& canvas, const CircleInstances& circles) {
+        if (circles.count <= 0 || palette_.empty()) return;
+        float min_hdr = 1.0f;
+        float hdr_step = 0.0f;
+        int num_keys = sortByKey(circles.count, circles.color_index, circles.alpha, circles.hdr, min_hdr, hdr_step);
+
+        for (int key = 0; key < num_keys; ++key) {
+            int start = key_start_[key];
+            int end = key_start_[key + 1];
+            if (start == end) continue;
+
+            canvas.setColor(keyColor(key, min_hdr, hdr_step));
+            for (int k = start; k < end; ++k) {
+                int i = order_[k];
+                float radius = circles.radius ? circles.radius[i] : circles.constant_radius;
+                canvas.circle(circles.x[i] - radius, circles.y[i] - radius, radius * 2.0f);
+            }
+        }
+    }
+
+    void drawLines(visage::Canvas& canvas, const LineInstances& lines) {
+        if (lines.count <= 0 || palette_.empty()) return;
+        float min_hdr = 1.0f;
+        float hdr_step = 0.0f;
+        int num_keys = sortByKey(lines.count, lines.color_index, lines.alpha, nullptr, min_hdr, hdr_step);
+        float half_width = 0.5f * lines.thickness;
+
+        for (int key = 0; key < num_keys; ++key) {
+            int start = key_start_[key];
+            int end = key_start_[key + 1];
+            if (start == end) continue;
+
+            canvas.setColor(keyColor(key, min_hdr, hdr_step));
+            for (int k = start; k < end; ++k) {
+                int i = order_[k];
+                float dx = lines.x2[i] - lines.x1[i];
+                float dy = lines.y2[i] - lines.y1[i];
+                float length_sq = dx * dx + dy * dy;
+                if (length_sq < 1e-12f) continue;
+
+                float scale = half_width / std::sqrt(length_sq);
+                float nx = -dy * scale;
+                float ny = dx * scale;
+                float ax = lines.x1[i] + nx, ay = lines.y1[i] + ny;
+                float bx = lines.x2[i] + nx, by = lines.y2[i] + ny;
+                float cx = lines.x2[i] - nx, cy = lines.y2[i] - ny;
+                float ex = lines.x1[i] - nx, ey = lines.y1[i] - ny;
+                canvas.triangle(ax, ay, bx, by, cx, cy);
+                canvas.triangle(ax, ay, cx, cy, ex, ey);
+            }
+        }
+    }
+
+    // Colour changes made by the last draw call, for profiling.
+    int numColorChanges() const { return num_color_changes_; }
+
+private:
+    // Counting sort of the instances into order_ by palette entry, alpha level and
+    // HDR level. Returns the number of keys; key_start_ holds each key's run.
+    int sortByKey(int count, const uint8_t* color_index, const float* alpha, const float* hdr,
+                  float& min_hdr, float& hdr_step) {
+        has_alpha_ = alpha != nullptr;
+        has_hdr_ = hdr != nullptr;
+        min_hdr = 1.0f;
+        float max_hdr = 1.0f;
+        if (hdr) {
+            min_hdr = max_hdr = hdr[0];
+            for (int i = 1; i < count; ++i) {
+                min_hdr = std::min(min_hdr, hdr[i]);
+                max_hdr = std::max(max_hdr, hdr[i]);
+            }
+        }
+        float hdr_range = max_hdr - min_hdr;
+        hdr_step = hdr_range / (kLevels - 1);
+        float to_hdr_level = hdr_range > 1e-4f ? (kLevels - 1) / hdr_range : 0.0f;
+
+        int palette_size = static_cast<int>(palette_.size());
+        int num_keys = palette_size * kLevels * kLevels;
+        keys_.resize(count);
+        key_start_.assign(num_keys + 1, 0);
+        for (int i = 0; i < count; ++i) {
+            int entry = color_index ? std::min<int>(color_index[i], palette_size - 1) : 0;
+            float a = alpha ? std::min(std::max(alpha[i], 0.0f), 1.0f) : 0.0f;
+            int alpha_level = static_cast<int>(a * (kLevels - 1) + 0.5f);
+            int hdr_level = hdr ? static_cast<int>((hdr[i] - min_hdr) * to_hdr_level + 0.5f) : 0;
+            int key = (entry * kLevels + alpha_level) * kLevels + hdr_level;
+            keys_[i] = static_cast<uint16_t>(key);
+            ++key_start_[key + 1];
+        }
+
+        num_color_changes_ = 0;
+        for (int key = 0; key < num_keys; ++key) {
+            if (key_start_[key + 1]) ++num_color_changes_;
+            key_start_[key + 1] += key_start_[key];
+        }
+
+        order_.resize(count);
+        fill_.assign(key_start_.begin(), key_start_.end() - 1);
+        for (int i = 0; i < count; ++i)
+            order_[fill_[keys_[i]]++] = i;
+        return num_keys;
+    }
+
+    visage::Color keyColor(int key, float min_hdr, float hdr_step) const {
+        int hdr_level = key % kLevels;
+        int alpha_level = (key / kLevels) % kLevels;
+        int entry = key / (kLevels * kLevels);
+
+        visage::Color color = palette_[entry];
+        if (has_alpha_)
+            color.setAlpha(static_cast<uint8_t>(255.0f * alpha_level / (kLevels - 1) + 0.5f));
+        if (has_hdr_)
+            color.setHdr(min_hdr + hdr_level * hdr_step);
+        return color;
+    }
+
+    std::vector<visage::Color> palette_;
+    std::vector<uint16_t> keys_;
+    std::vector<int> key_start_;
+    std::vector<int> fill_;
+    std::vector<int> order_;
+    int num_color_changes_ = 0;
+    bool has_alpha_ = false;
+    bool has_hdr_ = false;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "visage/ui.h"
+#include "animation_scheduler.h"
+#include <cstddef>
+#include <vector>
+#include <algorithm> // For std::find and std::remove
+
+class CachedLayer;
+
+/**
+ * @brief Totals over every CachedLayer in the app.
+ */
+struct LayerCacheStats {
+    int layers = 0;             // Attached layers
+    long long renders = 0;      // Times a layer was re-rasterized into its texture (misses)
+    long long composites = 0;   // Frames in which a showing layer was composited
+    size_t texture_bytes = 0;   // Estimated memory held by the layers' textures
+
+    /** @brief Fraction of composites served straight from the texture. */
+    double hitRate() const {
+        if (composites <= 0) return 0.0;
+        return std::max(0.0, static_cast<double>(composites - renders) / composites);
+    }
+};
+
+/**
+ * @class LayerCache
+ * @brief Keeps the statistics for all CachedLayers.
+ *
+ * Each scheduler tick that redraws something produces a new frame on screen.
+ * Every showing layer is composited into that frame, and it counts as a hit
+ * unless its subtree was re-rendered for it.
+ */
+class LayerCache : public SchedulerListener {
+public:
+    static constexpr int kBytesPerPixel = 4; // RGBA8 layer textures
+
+    static LayerCache& shared() {
+        static LayerCache cache;
+        return cache;
+    }
+
+    ~LayerCache() override { AnimationScheduler::shared().removeListener(this); }
+
+    inline LayerCacheStats stats() const;
+    inline void schedulerTicked(const SchedulerStats& stats) override;
+
+private:
+    friend class CachedLayer;
+
+    LayerCache() { AnimationScheduler::shared().addListener(this); }
+
+    void add(CachedLayer* layer) { layers_.push_back(layer); }
+    void remove(CachedLayer* layer) { layers_.erase(std::remove(layers_.begin(), layers_.end(), layer), layers_.end()); }
+
+    std::vector<CachedLayer*> layers_;
+};
+
+/**
+ * @class CachedLayer
+ * @brief Opt-in render-to-texture caching for a frame and its children.
+ *
+ * attach() turns on visage's cached layer for the frame: the subtree draws
+ * once into an offscreen texture, which is then only composited until the
+ * frame is resized or invalidate() is called. Call noteRendered() from the
+ * frame's draw so the layer can tell texture hits from re-renders.
+ */
+class CachedLayer {
+public:
+    CachedLayer() = default;
+    ~CachedLayer() { detach(); }
+
+    CachedLayer(const CachedLayer&) = delete;
+    CachedLayer& operator=(const CachedLayer&) = delete;
+
+    void attach(visage::Frame* frame) {
+        detach();
+        frame_ = frame;
+        frame_->setCached(true);
+        LayerCache::shared().add(this);
+    }
+
+    void detach() {
+        if (!frame_) return;
+        frame_->setCached(false);
+        LayerCache::shared().remove(this);
+        frame_ = nullptr;
+    }
+
+    /** @brief Re-renders the subtree into its texture on the next frame, after a content change. */
+    void invalidate() {
+        if (frame_)
+            frame_->redraw();
+    }
+
+    void noteRendered() {
+        ++renders_;
+        rendered_ = true;
+    }
+
+    long long renders() const { return renders_; }
+    long long composites() const { return composites_; }
+
+    /** @brief Estimated texture memory; zero until the layer has been rendered once. */
+    size_t textureBytes() const {
+        if (!frame_ || !rendered_) return 0;
+        return static_cast<size_t>(frame_->width()) * frame_->height() * LayerCache::kBytesPerPixel;
+    }
+
+private:
+    friend class LayerCache;
+
+    visage::Frame* frame_ = nullptr;
+    long long renders_ = 0;
+    long long composites_ = 0;
+    bool rendered_ = false;
+};
+
+LayerCacheStats LayerCache::stats() const {
+    LayerCacheStats stats;
+    stats.layers = static_cast<int>(layers_.size());
+    for (const CachedLayer* layer : layers_) {
+        stats.renders += layer->renders_;
+        stats.composites += layer->composites_;
+        stats.texture_bytes += layer->textureBytes();
+    }
+    return stats;
+}
+
+void LayerCache::schedulerTicked(const SchedulerStats& stats) {
+    if (!stats.ticked) return;
+    for (CachedLayer* layer : layers_) {
+        if (layer->rendered_ && AnimationScheduler::isShowing(layer->frame_))
+            ++layer->composites_;
+    }
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <algorithm> // Required for std::max
+
+#include <visage/app.h>
+#include "visage/graphics.h"
+#include "visage/ui.h"
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+#include "spline.h"
+#include "button.h"
+
+#include "simple_frame.h"
+#include "NeuralNetVisage.h"
+#include "animation_scheduler.h"
+#include "idle_monitor.h"
+#include "debug_overlay.h"
+#include "shared_bloom.h"
+#include "quality_governor.h"
+#include "view_manager.h"
+#include "page_data.h"
+#include "proportional_layout.h"
+#include "hit_test_index.h"
+#include "pointer_coalescer.h"
+
+// Quality knobs that apply to a view's animation; most animations have none.
+template <typename Animation>
+void applyAnimationQuality(Animation&, const QualitySettings&) {}
+
+inline void applyAnimationQuality(SplineDeformation& animation, const QualitySettings& settings) {
+    animation.setSplineTolerance(settings.spline_tolerance);
+}
+
+inline void applyAnimationQuality(CosmicPulsarAnimation& animation, const QualitySettings& settings) {
+    animation.setMaxParticles(settings.max_particles);
+}
+
+// One slide: a text page over an animation. The animation sits below the buttons and the
+// page above them, so the two are separate children of the root.
+class Slide : public ViewContent {
+public:
+    virtual visage::Frame& page() = 0;
+    virtual visage::Frame& animation() = 0;
+    virtual void applyQuality(const QualitySettings& settings) = 0;
+    // Registers both frames' placement; the layout keeps them sized from then on.
+    virtual void addToLayout(ProportionalLayout& layout) = 0;
+    void removeFromLayout(ProportionalLayout& layout) {
+        layout.remove(&page());
+        layout.remove(&animation());
+    }
+};
+
+template <typename Animation>
+class SlideView : public Slide {
+public:
+    // inset is the animation's left and right margin as a fraction of the width.
+    SlideView(const PageData& page, int width, int height, float inset) : page_(width, height), inset_(inset) {
+        page_.setPage(page);
+    }
+
+    void addToLayout(ProportionalLayout& layout) override {
+        // The page's text scales with the canvas rather than with the page itself.
+        layout.set(&page_, { 0.125f, 0.125f, 0.75f, 0.75f }, [this, &layout](const LayoutBox&) {
+            page_.setReferenceSize(layout.width(), layout.height());
+        });
+        layout.set(&animation_, { inset_, inset_ + 0.15f, 1.0f - 2.0f * inset_, 1.0f - 2.0f * inset_ });
+    }
+
+    void setVisible(bool visible) override {
+        page_.setVisible(visible);
+        animation_.setVisible(visible);
+    }
+
+    visage::Frame& page() override { return page_; }
+    visage::Frame& animation() override { return animation_; }
+    void applyQuality(const QualitySettings& settings) override { applyAnimationQuality(animation_, settings); }
+
+private:
+    SlidePage page_;
+    Animation animation_;
+    float inset_;
+};
+
+inline std::unique_ptr<Slide> makeSlide(const PageData& page, int width, int height) {
+    switch (page.animation) {
+    case PageAnimation::kShards:
+        return std::make_unique<SlideView<RotatingShardsAnimation>>(page, width, height, 0.3f);
+    case PageAnimation::kPulsar:
+        return std::make_unique<SlideView<CosmicPulsarAnimation>>(page, width, height, 0.25f);
+    case PageAnimation::kSpline:
+        return std::make_unique<SlideView<SplineDeformation>>(page, width, height, 0.25f);
+    default:
+        return std::make_unique<SlideView<AnimatedCircle>>(page, width, height, 0.25f);
+    }
+}
+
+// *** STEP 1: Inherit from visage::ApplicationEditor ***
+class MyApp : public visage::ApplicationEditor {
+public:
+    // width and height are the canvas size at startup; visibility tells the idle monitor
+    // whether the page is shown. Nothing reaches the page until connectToPage().
+    MyApp(int width, int height, VisibilitySource& visibility) : idle_monitor_(visibility) {
+        std::cout << "MyApp constructor started." << std::endl;
+        setIgnoresMouseEvents(false, false);
+        // One bloom pass over the whole app; frames glow through the HDR they draw.
+        bloom_.attach(this);
+        // Add the SplineDeformation as a child of this Frame.
+        addChild(&spline_deformation_);
+
+        int button_size = width * 0.10f; // Set button size to 15% of the width.
+        previous_button = std::make_unique<Button>(button_size, button_size);
+        addChild(*previous_button.get()); // Add the button to the application editor.
+
+        next_button = std::make_unique<ButtonRight>(button_size, button_size);
+        addChild(*next_button.get()); // Add the button to the application editor.
+
+        border = std::make_unique<AnimatedBorder>();
+        addChild(*border.get());
+
+        // Everything is placed as fractions of the canvas; buttons stay square at 10% of the width.
+        layout_.set(&spline_deformation_, { 0.0f, 0.0f, 1.0f, 1.0f });
+        layout_.set(previous_button.get(), { 0.15f, 0.72f, 0.10f, 0.0f, true }, [this](const LayoutBox& box) {
+            previous_button->set_frames(box.width, box.height);
+        });
+        layout_.set(next_button.get(), { 0.75f, 0.72f, 0.10f, 0.0f, true }, [this](const LayoutBox& box) {
+            next_button->set_frames(box.width, box.height);
+        });
+        layout_.set(border.get(), { 0.0f, 0.0f, 1.0f, 1.0f });
+
+        // Slides are built when first shown or prefetched next to the current one, and
+        // dropped again once navigation moves away from them. Their content arrives in
+        // pages.bin, fetched after startup; see loadPages().
+        views_.onCreated() = [this](int, ViewContent& content) {
+            Slide& slide = static_cast<Slide&>(content);
+            slide.applyQuality(quality_.currentSettings());
+            addChild(&slide.animation(), false);
+            addChild(&slide.page(), false);
+            restack();
+            slide.addToLayout(layout_);
+            layout_.update();
+        };
+        views_.onEvicted() = [this](int, ViewContent& content) {
+            Slide& slide = static_cast<Slide&>(content);
+            slide.removeFromLayout(layout_);
+            removeChild(&slide.animation());
+            removeChild(&slide.page());
+        };
+
+        // A hidden page renders nothing: the scheduler stops and so does the main loop.
+        // Resuming restarts both, and animations pick up from the current time.
+        idle_monitor_.onStateChanged() = [](IdleState state) {
+            if (state == IdleState::kSuspended)
+                emscripten_pause_main_loop();
+            else
+                emscripten_resume_main_loop();
+        };
+        idle_monitor_.start();
+
+        // Debug overlay for redrawn regions, on top of everything; see show_redraw_regions().
+        addChild(&redraw_overlay_);
+        layout_.set(&redraw_overlay_, { 0.0f, 0.0f, 1.0f, 1.0f });
+        layout_.setParentSize(width, height);
+        layout_.update();
+
+        hit_targets_.push_back({ previous_button.get(),
+                                 [this](bool hovered) { previous_button->set_bloom(hovered ? kHoverBloom : 0.0f); },
+                                 [this] { showAdjacentView(-1); } });
+        hit_targets_.push_back({ next_button.get(),
+                                 [this](bool hovered) { next_button->set_bloom(hovered ? kHoverBloom : 0.0f); },
+                                 [this] { showAdjacentView(1); } });
+        rebuildHitIndex();
+        pointer_.onMove() = [this](visage::Point position) { setHovered(hit_index_.hitTest(position.x, position.y)); };
+
+        redraw_overlay_.setQualityGovernor(&quality_);
+        redraw_overlay_.setLayout(&layout_);
+
+        // Trade detail for frame rate on slow devices; the top level is the original look.
+        quality_.onLevelChanged() = [this](int, const QualitySettings& settings) { applyQuality(settings); };
+        applyQuality(quality_.currentSettings());
+    }
+
+    ~MyApp() {
+        std::cout << "MyApp destructor called." << std::endl;
+        if (connected_) {
+            emscripten_set_visibilitychange_callback(nullptr, EM_FALSE, nullptr);
+            active_app = nullptr;
+        }
+        // The destructor will automatically clean up children.
+        removeChild(&spline_deformation_);
+        views_.clear();
+        previous_button = nullptr; // Reset the unique_ptr to ensure it cleans up.
+        next_button = nullptr; // Reset the unique_ptr to ensure it cleans up.
+        border = nullptr;
+    }
+
+    // This is the CORRECT way to provide drawing logic for a Frame subclass.
+    // We override the virtual 'draw' method from the base class.
+    void draw(visage::Canvas& canvas) override {
+
+        canvas.setColor(0xff101214);
+        
+        // Fill the entire area of this frame (which is the whole window).
+        canvas.fill(0, 0, width(), height());
+    }
+
+    // Resizes the app in place for a new canvas size: one relayout of the live frames,
+    // without rebuilding anything.
+    void resizeTo(int width, int height) {
+        if (width <= 0 || height <= 0) return;
+        if (width == layout_.width() && height == layout_.height()) return;
+        setNativeDimensions(width, height);
+        layout_.setParentSize(width, height);
+        layout_.update();
+        rebuildHitIndex();
+        redraw();
+        AnimationScheduler::shared().wake();
+    }
+
+    // Input the root frame doesn't see, forwarded from the page.
+    void noteUserActivity() { idle_monitor_.noteActivity(); }
+
+    void setShowRedrawRegions(bool show) { redraw_overlay_.setEnabled(show); }
+
+    QualityGovernor& quality() { return quality_; }
+
+    // Set while the app is connected so calls from the page can reach it.
+    inline static MyApp* active_app = nullptr;
+
+    // Fetches pages.bin and follows the page's visibility. Separate from the constructor
+    // so the app can be built and driven without a page.
+    void connectToPage() {
+        if (connected_) return;
+        connected_ = true;
+        emscripten_async_wget_data(kPagesUrl, this, onPagesLoaded, onPagesFailed);
+        active_app = this;
+        emscripten_set_visibilitychange_callback(this, EM_FALSE, onVisibilityChange);
+    }
+
+    // Shows one view and hides the rest, building it first if needed. Hidden frames
+    // drop out of the animation scheduler, so only the current view keeps animating.
+    void showView(int index) {
+        views_.show(index);
+        AnimationScheduler::shared().wake();
+    }
+
+    // Registers one view per page in the book and shows the first. A book that can't be
+    // read leaves the current slides alone, or shows the fallback page if there are none.
+    void loadPages(const void* data, int size) {
+        if (!pages_.load(data, size)) {
+            std::cerr << "pages.bin is not a page book this build can read, or is empty." << std::endl;
+            if (!pages_.loaded())
+                showFallbackPage();
+            return;
+        }
+        views_.removeAllViews();
+        for (int i = 0; i < pages_.numPages(); ++i) {
+            views_.addView([this, i] {
+                PageData page;
+                if (!pages_.decode(i, page))
+                    std::cerr << "Page " << i << " in pages.bin is malformed." << std::endl;
+                return makeSlide(page, layout_.width(), layout_.height());
+            });
+        }
+        viewIndex = 0;
+        showView(viewIndex);
+    }
+
+    // One built-in slide, for when no page book could be loaded.
+    void showFallbackPage() {
+        views_.removeAllViews();
+        views_.addView([this] { return makeSlide(fallbackPage(), layout_.width(), layout_.height()); });
+        viewIndex = 0;
+        showView(viewIndex);
+    }
+
+    // For checks without a renderer: the layout, the views, the fixed frames and the hit
+    // target under a point.
+    const ProportionalLayout& proportionalLayout() const { return layout_; }
+    const ViewManager& views() const { return views_; }
+    const visage::Frame* background() const { return &spline_deformation_; }
+    const visage::Frame* borderFrame() const { return border.get(); }
+    const visage::Frame* previousButton() const { return previous_button.get(); }
+    const visage::Frame* nextButton() const { return next_button.get(); }
+    visage::Frame* hitTest(float x, float y) const {
+        int target = hit_index_.hitTest(x, y);
+        return target >= 0 ? hit_targets_[target].frame : nullptr;
+    }
+
+    void mouseDown(const visage::MouseEvent& e) override {
+        idle_monitor_.noteActivity();
+        pointer_.flush();
+        int target = hit_index_.hitTest(e.position.x, e.position.y);
+        if (target >= 0 && hit_targets_[target].on_click)
+            hit_targets_[target].on_click();
+    }
+
+    // Moves are coalesced to one per frame; hover is resolved in setHovered().
+    void mouseMove(const visage::MouseEvent& e) override {
+        idle_monitor_.noteActivity();
+        pointer_.move(e.position);
+    }
+private:
+    static constexpr float kHoverBloom = 40.0f;
+
+    // Something in the root that reacts to the pointer; ids in hit_index_ index hit_targets_.
+    struct HitTarget {
+        visage::Frame* frame;
+        std::function<void(bool)> on_hover;
+        std::function<void()> on_click;
+    };
+
+    void showAdjacentView(int step) {
+        int num_views = views_.numViews();
+        if (num_views == 0) return;
+        viewIndex = ((viewIndex + step) % num_views + num_views) % num_views;
+        showView(viewIndex);
+    }
+
+    // Hover work only happens when the target under the pointer changes.
+    void setHovered(int target) {
+        if (target == hovered_) return;
+        if (hovered_ >= 0 && hit_targets_[hovered_].on_hover)
+            hit_targets_[hovered_].on_hover(false);
+        hovered_ = target;
+        if (hovered_ >= 0 && hit_targets_[hovered_].on_hover)
+            hit_targets_[hovered_].on_hover(true);
+    }
+
+    // Hit targets are placed by layout_, so the index follows every relayout.
+    void rebuildHitIndex() {
+        hit_index_.clear();
+        for (int i = 0; i < static_cast<int>(hit_targets_.size()); ++i) {
+            if (const LayoutBox* box = layout_.box(hit_targets_[i].frame))
+                hit_index_.add(i, *box);
+        }
+        hit_index_.build(layout_.width(), layout_.height());
+    }
+
+    void applyQuality(const QualitySettings& settings) {
+        bloom_.setSize(settings.bloom_size);
+        previous_button->setSplineTolerance(settings.spline_tolerance);
+        next_button->setSplineTolerance(settings.spline_tolerance);
+        border->setNumSegments(settings.border_segments);
+        spline_deformation_.webFrame().setNumPoints(settings.web_points);
+        views_.forEachLive([&](int, ViewContent& content) { static_cast<Slide&>(content).applyQuality(settings); });
+    }
+
+    // Children draw in the order they were added. A slide built later is appended on top,
+    // so the frames above the slide animations are re-added to restore the original order:
+    // animations, buttons, pages, border, overlay.
+    void restack() {
+        std::vector<visage::Frame*> order;
+        views_.forEachLive([&](int, ViewContent& content) { order.push_back(&static_cast<Slide&>(content).animation()); });
+        order.push_back(previous_button.get());
+        order.push_back(next_button.get());
+        views_.forEachLive([&](int, ViewContent& content) { order.push_back(&static_cast<Slide&>(content).page()); });
+        order.push_back(border.get());
+        order.push_back(&redraw_overlay_);
+
+        for (visage::Frame* frame : order) {
+            bool visible = frame->isVisible();
+            removeChild(frame);
+            addChild(frame, visible);
+        }
+    }
+
+    static void onPagesLoaded(void* user_data, void* data, int size) {
+        static_cast<MyApp*>(user_data)->loadPages(data, size);
+    }
+
+    static void onPagesFailed(void* user_data) {
+        std::cerr << "Could not fetch " << kPagesUrl << "." << std::endl;
+        MyApp* app = static_cast<MyApp*>(user_data);
+        if (!app->pages_.loaded())
+            app->showFallbackPage();
+    }
+
+    static EM_BOOL onVisibilityChange(int, const EmscriptenVisibilityChangeEvent*, void* user_data) {
+        static_cast<MyApp*>(user_data)->idle_monitor_.update();
+        return EM_FALSE;
+    }
+
+    IdleMonitor idle_monitor_;
+    RedrawRegionOverlay redraw_overlay_;
+    SharedBloom bloom_;
+    QualityGovernor quality_;
+    int last_view = 0;
+    int viewIndex = 0;
+    // Our child component.
+    NeuralNetVisage spline_deformation_;
+    std::unique_ptr<Button> previous_button; // Example button, can be used later.
+    std::unique_ptr<ButtonRight> next_button; // Example button, can be used later.
+    int count = 0 ;
+    std::unique_ptr<AnimatedBorder> border;
+    static constexpr const char* kPagesUrl = "pages.bin";
+    ProportionalLayout layout_;
+    PageBook pages_;
+    ViewManager views_;
+    std::vector<HitTarget> hit_targets_;
+    HitTestIndex hit_index_;
+    int hovered_ = -1;
+    PointerCoalescer pointer_;
+    bool connected_ = false;
+};
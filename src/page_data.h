@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The animation shown behind a page, in the order tools/pack_pages.py numbers them.
+ */
+enum class PageAnimation : uint8_t {
+    kCircle,
+    kShards,
+    kPulsar,
+    kSpline,
+    kCount
+};
+
+/**
+ * @brief One line of page text. Size and y are fractions of the reference height.
+ */
+struct PageRun {
+    std::string text;
+    float size = 0.0f;
+    float y = 0.0f;
+};
+
+struct PageData {
+    PageAnimation animation = PageAnimation::kCircle;
+    std::vector<PageRun> runs;
+};
+
+/**
+ * @brief The page shown when no book could be loaded, so the app never starts blank.
+ */
+inline PageData fallbackPage() {
+    PageData page;
+    page.animation = PageAnimation::kCircle;
+    page.runs = {
+        { "Welcome!", 0.05f, 0.1f },
+        { "What you are seeing is a Hardware Accelerated Website In C++.", 0.03f, 0.2f },
+        { "The slides could not be loaded. Please reload the page.", 0.025f, 0.3f },
+    };
+    return page;
+}
+
+/**
+ * @class PageBook
+ * @brief The packed slide pages, as produced by tools/pack_pages.py.
+ *
+ * load() only checks the header and the offset table; pages are decoded one
+ * at a time by decode() when a view is built, so the cost of a large book is
+ * one copy of its bytes rather than one object per page. A book that fails
+ * those checks is not taken, and the one loaded before stays in place.
+ */
+class PageBook {
+public:
+    static constexpr char kMagic[4] = { 'H', 'M', 'P', 'G' };
+    static constexpr uint16_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 8;
+    static constexpr float kUnitsPerHeight = 1000.0f;
+
+    /**
+     * @brief Takes a copy of a packed book; false, keeping the current book, if it is not
+     *        one this build can read or has no pages.
+     */
+    bool load(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        if (size < kHeaderSize || std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0)
+            return false;
+        if (readU16(bytes, 4) != kVersion)
+            return false;
+
+        int num_pages = readU16(bytes, 6);
+        if (num_pages == 0)
+            return false;
+        size_t table_end = kHeaderSize + 4 * (static_cast<size_t>(num_pages) + 1);
+        if (table_end > size)
+            return false;
+
+        uint32_t previous = static_cast<uint32_t>(table_end);
+        for (int i = 0; i <= num_pages; ++i) {
+            uint32_t offset = readU32(bytes, kHeaderSize + 4 * i);
+            if (offset < previous || offset > size)
+                return false;
+            previous = offset;
+        }
+        bytes_.assign(bytes, bytes + size);
+        num_pages_ = num_pages;
+        return true;
+    }
+
+    bool loaded() const { return num_pages_ > 0; }
+    int numPages() const { return num_pages_; }
+    size_t sizeBytes() const { return bytes_.size(); }
+
+    /** @brief Decodes one page; false if the index or the page record is invalid. */
+    bool decode(int index, PageData& page) const {
+        page.runs.clear();
+        if (index < 0 || index >= num_pages_) return false;
+        size_t position = pageOffset(index);
+        size_t end = pageOffset(index + 1);
+        if (end - position < 2) return false;
+
+        uint8_t animation = bytes_[position];
+        int num_runs = bytes_[position + 1];
+        position += 2;
+        if (animation >= static_cast<uint8_t>(PageAnimation::kCount)) return false;
+        page.animation = static_cast<PageAnimation>(animation);
+
+        page.runs.resize(num_runs);
+        for (PageRun& run : page.runs) {
+            if (end - position < 6) return false;
+            run.size = readU16(position) / kUnitsPerHeight;
+            run.y = readU16(position + 2) / kUnitsPerHeight;
+            size_t length = readU16(position + 4);
+            position += 6;
+            if (end - position < length) return false;
+            run.text.assign(reinterpret_cast<const char*>(bytes_.data() + position), length);
+            position += length;
+        }
+        return true;
+    }
+
+private:
+    size_t pageOffset(int index) const { return readU32(kHeaderSize + 4 * index); }
+
+    uint16_t readU16(size_t position) const { return readU16(bytes_.data(), position); }
+    uint32_t readU32(size_t position) const { return readU32(bytes_.data(), position); }
+
+    static uint16_t readU16(const uint8_t* bytes, size_t position) {
+        return static_cast<uint16_t>(bytes[position] | (bytes[position + 1] << 8));
+    }
+
+    static uint32_t readU32(const uint8_t* bytes, size_t position) {
+        return static_cast<uint32_t>(bytes[position]) | (static_cast<uint32_t>(bytes[position + 1]) << 8) |
+               (static_cast<uint32_t>(bytes[position + 2]) << 16) | (static_cast<uint32_t>(bytes[position + 3]) << 24);
+    }
+
+    std::vector<uint8_t> bytes_;
+    int num_pages_ = 0;
+};
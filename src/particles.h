@@ -0,0 +1,229 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm> // For std::min/max
+
+/**
+ * @brief std::allocator replacement that hands out Alignment-aligned storage, so
+ *        the particle channels start on a SIMD register boundary.
+ */
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template <typename U> bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+/**
+ * @brief Branch-free sine, accurate to about 1e-3, for per-particle pulses.
+ *        Unlike std::sin it inlines into a loop the compiler can vectorize.
+ */
+inline float fastSin(float x) {
+    constexpr float kPi = 3.14159265f;
+    constexpr float kInvTwoPi = 1.0f / (2.0f * kPi);
+    // Reduce to [-pi, pi] by subtracting the nearest whole turn.
+    float turns = x * kInvTwoPi;
+    turns = static_cast<float>(static_cast<int>(turns + (turns < 0.0f ? -0.5f : 0.5f)));
+    x -= turns * (2.0f * kPi);
+
+    // Parabolic approximation plus one refinement step.
+    float abs_x = x < 0.0f ? -x : x;
+    float y = (4.0f / kPi) * x - (4.0f / (kPi * kPi)) * x * abs_x;
+    float abs_y = y < 0.0f ? -y : y;
+    return 0.225f * (y * abs_y - y) + y;
+}
+
+/**
+ * @brief Writes a sharp 0..1 pulse per entry: ((sin(angle + phase) + 1) / 2)^4.
+ *        angle should already be wrapped to a turn to keep float precision.
+ */
+inline void computePulses(const float* phase, int begin, int end, float angle, float* out) {
+    for (int i = begin; i < end; ++i) {
+        float pulse = (fastSin(angle + phase[i]) + 1.0f) * 0.5f;
+        pulse *= pulse;
+        out[i] = pulse * pulse;
+    }
+}
+
+/**
+ * @class ParticleArrays
+ * @brief Fixed-capacity structure-of-arrays particle pool with batch update kernels.
+ *
+ * Every attribute lives in its own aligned array, and the kernels below are
+ * flat loops over those arrays with no branches or library calls, so they
+ * vectorize instead of walking one struct at a time. All storage is allocated
+ * by setCapacity(); add() and removeDead() only move the live count, so a
+ * running effect makes no allocations.
+ */
+class ParticleArrays {
+public:
+    static constexpr std::size_t kAlignment = 32;
+    using FloatArray = std::vector<float, AlignedAllocator<float, kAlignment>>;
+
+    /** @brief Allocates room for capacity particles and drops any live ones. */
+    void setCapacity(int capacity) {
+        for (FloatArray* channel : floatChannels())
+            channel->assign(capacity, 0.0f);
+        tag_.assign(capacity, 0);
+        capacity_ = capacity;
+        size_ = 0;
+    }
+
+    void clear() { size_ = 0; }
+
+    /**
+     * @brief Adds a particle and returns its index, or -1 if the pool is full.
+     *        lifetime is the initial lifetime in seconds, phase a per-particle
+     *        offset for pulses, and tag a small caller-defined value such as a
+     *        colour index.
+     */
+    int add(float x, float y, float vx, float vy, float lifetime, float phase = 0.0f, uint8_t tag = 0) {
+        if (size_ >= capacity_) return -1;
+        int i = size_++;
+        x_[i] = x;
+        y_[i] = y;
+        vx_[i] = vx;
+        vy_[i] = vy;
+        life_[i] = lifetime;
+        inv_lifetime_[i] = lifetime > 0.0f ? 1.0f / lifetime : 0.0f;
+        phase_[i] = phase;
+        tag_[i] = tag;
+        return i;
+    }
+
+    /**
+     * @brief Removes every particle whose life has run out by moving the last
+     *        live particle into its slot. O(n) for the pass, O(1) per removal;
+     *        the order of the survivors is not kept.
+     */
+    void removeDead() {
+        int i = 0;
+        while (i < size_) {
+            if (life_[i] > 0.0f) {
+                ++i;
+                continue;
+            }
+            int last = --size_;
+            x_[i] = x_[last];
+            y_[i] = y_[last];
+            vx_[i] = vx_[last];
+            vy_[i] = vy_[last];
+            life_[i] = life_[last];
+            inv_lifetime_[i] = inv_lifetime_[last];
+            phase_[i] = phase_[last];
+            tag_[i] = tag_[last];
+        }
+    }
+
+    // --- Kernels ---
+    // Each kernel has a [begin, end) overload so disjoint ranges can run on
+    // separate threads; the short form covers every live particle.
+
+    /** @brief Advances positions by velocity * dt. */
+    void integrate(float dt) { integrate(dt, 0, size_); }
+    void integrate(float dt, int begin, int end) {
+        float* x = x_.data();
+        float* y = y_.data();
+        const float* vx = vx_.data();
+        const float* vy = vy_.data();
+        for (int i = begin; i < end; ++i) {
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+        }
+    }
+
+    /**
+     * @brief Clamps positions into the box and reflects the velocity of any
+     *        particle that was outside it.
+     */
+    void bounce(float min_x, float min_y, float max_x, float max_y) { bounce(min_x, min_y, max_x, max_y, 0, size_); }
+    void bounce(float min_x, float min_y, float max_x, float max_y, int begin, int end) {
+        bounceAxis(x_.data(), vx_.data(), begin, end, min_x, max_x);
+        bounceAxis(y_.data(), vy_.data(), begin, end, min_y, max_y);
+    }
+
+    /** @brief Subtracts dt from every particle's remaining life. */
+    void age(float dt) { age(dt, 0, size_); }
+    void age(float dt, int begin, int end) {
+        float* life = life_.data();
+        for (int i = begin; i < end; ++i)
+            life[i] -= dt;
+    }
+
+    /** @brief Writes remaining life / initial lifetime, clamped to [0, 1], for fading. */
+    void lifeRatios(float* out) const { lifeRatios(out, 0, size_); }
+    void lifeRatios(float* out, int begin, int end) const {
+        const float* life = life_.data();
+        const float* inv_lifetime = inv_lifetime_.data();
+        for (int i = begin; i < end; ++i) {
+            float ratio = life[i] * inv_lifetime[i];
+            ratio = ratio < 0.0f ? 0.0f : ratio;
+            out[i] = ratio > 1.0f ? 1.0f : ratio;
+        }
+    }
+
+    /** @brief computePulses() over each particle's phase. */
+    void pulses(float angle, float* out) const { pulses(angle, out, 0, size_); }
+    void pulses(float angle, float* out, int begin, int end) const {
+        computePulses(phase_.data(), begin, end, angle, out);
+    }
+
+    int size() const { return size_; }
+    int capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ >= capacity_; }
+
+    float* x() { return x_.data(); }
+    float* y() { return y_.data(); }
+    float* vx() { return vx_.data(); }
+    float* vy() { return vy_.data(); }
+    float* life() { return life_.data(); }
+    const float* x() const { return x_.data(); }
+    const float* y() const { return y_.data(); }
+    const float* vx() const { return vx_.data(); }
+    const float* vy() const { return vy_.data(); }
+    const float* life() const { return life_.data(); }
+    const float* phase() const { return phase_.data(); }
+    const uint8_t* tag() const { return tag_.data(); }
+
+private:
+    static void bounceAxis(float* position, float* velocity, int begin, int end, float min_value, float max_value) {
+        for (int i = begin; i < end; ++i) {
+            float p = position[i];
+            float clamped = p < min_value ? min_value : p;
+            clamped = clamped > max_value ? max_value : clamped;
+            position[i] = clamped;
+            // Any particle the clamp moved was outside the box.
+            velocity[i] = clamped != p ? -velocity[i] : velocity[i];
+        }
+    }
+
+    std::array<FloatArray*, 7> floatChannels() {
+        return { &x_, &y_, &vx_, &vy_, &life_, &inv_lifetime_, &phase_ };
+    }
+
+    FloatArray x_;
+    FloatArray y_;
+    FloatArray vx_;
+    FloatArray vy_;
+    FloatArray life_;
+    FloatArray inv_lifetime_;
+    FloatArray phase_;
+    std::vector<uint8_t> tag_;
+    int size_ = 0;
+    int capacity_ = 0;
+};
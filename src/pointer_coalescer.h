@@ -0,0 +1,79 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include "animation_scheduler.h"
+#include <chrono>
+#include <functional>
+
+/**
+ * @class PointerCoalescer
+ * @brief Collapses pointer moves so at most one is handled per frame.
+ *
+ * Browsers can deliver several move events between two frames, and only the
+ * last position matters for hover. move() just records the position and
+ * wakes the scheduler; the handler runs from the next scheduler tick once a
+ * frame interval has passed since the previous one, with the latest
+ * position. Call flush() before handling a press so it sees current hover
+ * state.
+ */
+class PointerCoalescer : public SchedulerListener {
+public:
+    static constexpr double kDefaultIntervalSeconds = 1.0 / 60.0;
+
+    explicit PointerCoalescer(AnimationScheduler& scheduler = AnimationScheduler::shared())
+        : scheduler_(scheduler), epoch_(Clock::now()) {
+        scheduler_.addListener(this);
+    }
+
+    ~PointerCoalescer() override { scheduler_.removeListener(this); }
+
+    PointerCoalescer(const PointerCoalescer&) = delete;
+    PointerCoalescer& operator=(const PointerCoalescer&) = delete;
+
+    /** @brief Called with the latest position, at most once per frame. */
+    std::function<void(visage::Point)>& onMove() { return on_move_; }
+
+    void move(visage::Point position) {
+        position_ = position;
+        ++received_;
+        if (!pending_) {
+            pending_ = true;
+            scheduler_.wake();
+        }
+    }
+
+    void flush() {
+        if (!pending_) return;
+        pending_ = false;
+        last_dispatch_ = now();
+        ++dispatched_;
+        if (on_move_)
+            on_move_(position_);
+    }
+
+    void schedulerTicked(const SchedulerStats& stats) override {
+        if (!pending_) return;
+        double interval = stats.frame_interval > 0.0 ? stats.frame_interval : kDefaultIntervalSeconds;
+        if (now() - last_dispatch_ >= interval - AnimationScheduler::kSlackSeconds)
+            flush();
+        else
+            scheduler_.wake(); // An idle tick drops to the slow poll; keep ticking until dispatched
+    }
+
+    long long received() const { return received_; }
+    long long dispatched() const { return dispatched_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double now() const { return std::chrono::duration<double>(Clock::now() - epoch_).count(); }
+
+    AnimationScheduler& scheduler_;
+    Clock::time_point epoch_;
+    std::function<void(visage::Point)> on_move_;
+    visage::Point position_;
+    bool pending_ = false;
+    double last_dispatch_ = -1.0;
+    long long received_ = 0;
+    long long dispatched_ = 0;
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "visage/ui.h"
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <algorithm> // For std::max, std::remove and std::replace
+
+/**
+ * @brief A frame's placement as fractions of its parent's size.
+ *
+ * left and width are fractions of the parent width, top and height of the
+ * parent height. A square rect takes its height from its computed width,
+ * which keeps buttons round on any aspect ratio.
+ */
+struct ProportionalRect {
+    float left = 0.0f;
+    float top = 0.0f;
+    float width = 1.0f;
+    float height = 1.0f;
+    bool square = false;
+
+    bool operator==(const ProportionalRect& other) const {
+        return left == other.left && top == other.top && width == other.width && height == other.height &&
+               square == other.square;
+    }
+    bool operator!=(const ProportionalRect& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief A computed placement in parent pixels.
+ */
+struct LayoutBox {
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+
+    bool operator==(const LayoutBox& other) const {
+        return x == other.x && y == other.y && width == other.width && height == other.height;
+    }
+    bool operator!=(const LayoutBox& other) const { return !(*this == other); }
+};
+
+struct LayoutStats {
+    int nodes = 0;
+    int recomputed = 0;       // Nodes recomputed by the last update()
+    int applied = 0;          // Of those, nodes whose box actually changed
+    long long updates = 0;    // update() calls that had dirty nodes
+    double last_ms = 0.0;     // Time spent in the last such update()
+    double total_ms = 0.0;
+};
+
+/**
+ * @class ProportionalLayout
+ * @brief Places frames at fixed fractions of one parent size, recomputing
+ *        only what changed.
+ *
+ * Each frame's box is cached. Changing a frame's rect marks only that frame
+ * dirty; changing the parent size marks every frame dirty, since all of them
+ * are proportional to it. update() recomputes the dirty frames and writes
+ * margins and size to a frame's visage layout only when its box moved, so
+ * calling it with nothing dirty costs nothing and there is no per-frame
+ * layout work. The frames are expected to be direct children of the parent.
+ */
+class ProportionalLayout {
+public:
+    using Callback = std::function<void(const LayoutBox&)>;
+
+    /** @brief Adds or replaces a frame's rect. on_applied runs whenever its box changes. */
+    void set(visage::Frame* frame, const ProportionalRect& rect, Callback on_applied = nullptr) {
+        auto found = index_.find(frame);
+        if (found == index_.end()) {
+            index_[frame] = static_cast<int>(nodes_.size());
+            nodes_.push_back({ frame, rect, {}, std::move(on_applied), false, false });
+            markDirty(static_cast<int>(nodes_.size()) - 1);
+            return;
+        }
+
+        Node& node = nodes_[found->second];
+        if (on_applied)
+            node.on_applied = std::move(on_applied);
+        if (node.rect != rect) {
+            node.rect = rect;
+            markDirty(found->second);
+        }
+    }
+
+    void remove(visage::Frame* frame) {
+        auto found = index_.find(frame);
+        if (found == index_.end()) return;
+        int index = found->second;
+        index_.erase(found);
+
+        dirty_.erase(std::remove(dirty_.begin(), dirty_.end(), index), dirty_.end());
+        int last = static_cast<int>(nodes_.size()) - 1;
+        if (index != last) {
+            nodes_[index] = std::move(nodes_[last]);
+            index_[nodes_[index].frame] = index;
+            std::replace(dirty_.begin(), dirty_.end(), last, index);
+        }
+        nodes_.pop_back();
+    }
+
+    void setParentSize(float width, float height) {
+        if (width == width_ && height == height_) return;
+        width_ = width;
+        height_ = height;
+        for (int i = 0; i < static_cast<int>(nodes_.size()); ++i)
+            markDirty(i);
+    }
+
+    float width() const { return width_; }
+    float height() const { return height_; }
+
+    /** @brief The cached box for a frame, or nullptr if it is not laid out here. */
+    const LayoutBox* box(const visage::Frame* frame) const {
+        auto found = index_.find(const_cast<visage::Frame*>(frame));
+        return found == index_.end() ? nullptr : &nodes_[found->second].box;
+    }
+
+    /** @brief Recomputes dirty frames and applies the boxes that changed. */
+    void update() {
+        if (dirty_.empty()) return;
+        auto start = Clock::now();
+
+        stats_.recomputed = 0;
+        stats_.applied = 0;
+        // Callbacks may change rects, and anything they dirty is handled in this pass too,
+        // but they must not add or remove frames.
+        while (!dirty_.empty()) {
+            int index = dirty_.back();
+            dirty_.pop_back();
+            Node& node = nodes_[index];
+            node.dirty = false;
+            ++stats_.recomputed;
+
+            LayoutBox box = compute(node.rect);
+            if (node.applied && box == node.box)
+                continue;
+            node.box = box;
+            node.applied = true;
+            apply(node);
+            ++stats_.applied;
+        }
+
+        stats_.nodes = static_cast<int>(nodes_.size());
+        stats_.last_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        stats_.total_ms += stats_.last_ms;
+        ++stats_.updates;
+    }
+
+    bool dirty() const { return !dirty_.empty(); }
+    const LayoutStats& stats() const { return stats_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Node {
+        visage::Frame* frame;
+        ProportionalRect rect;
+        LayoutBox box;
+        Callback on_applied;
+        bool dirty;
+        bool applied;
+    };
+
+    void markDirty(int index) {
+        if (nodes_[index].dirty) return;
+        nodes_[index].dirty = true;
+        dirty_.push_back(index);
+    }
+
+    LayoutBox compute(const ProportionalRect& rect) const {
+        LayoutBox box;
+        box.x = rect.left * width_;
+        box.y = rect.top * height_;
+        box.width = rect.width * width_;
+        box.height = rect.square ? box.width : rect.height * height_;
+        return box;
+    }
+
+    // Margins on all four sides so the box holds however the parent distributes space.
+    void apply(Node& node) {
+        const LayoutBox& box = node.box;
+        visage::Frame* frame = node.frame;
+        frame->layout().setMarginLeft(box.x);
+        frame->layout().setMarginTop(box.y);
+        frame->layout().setMarginRight(std::max(0.0f, width_ - box.x - box.width));
+        frame->layout().setMarginBottom(std::max(0.0f, height_ - box.y - box.height));
+        frame->layout().setWidth(box.width);
+        frame->layout().setHeight(box.height);
+        if (node.on_applied)
+            node.on_applied(box);
+    }
+
+    std::vector<Node> nodes_;
+    std::unordered_map<visage::Frame*, int> index_;
+    std::vector<int> dirty_;
+    float width_ = 0.0f;
+    float height_ = 0.0f;
+    LayoutStats stats_;
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "animation_scheduler.h"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <algorithm> // For std::min/max
+
+/**
+ * @brief The knob values for one quality level.
+ */
+struct QualitySettings {
+    float bloom_size;        // Shared bloom size; 0 skips the bloom pass
+    float spline_tolerance;  // Pixels; a looser fit emits fewer spline segments
+    int border_segments;     // AnimatedBorder perimeter samples
+    int web_points;          // Nodes drawn by the node web
+    int max_particles;       // Live particles in the pulsar
+};
+
+/**
+ * @brief One level change made by the QualityGovernor, for tuning.
+ */
+struct QualityDecision {
+    double time;         // Governor time in seconds
+    int from_level;
+    int to_level;
+    double frame_ms;     // Smoothed interval between presented frames
+    double budget_ms;    // Interval it was held against
+    double load;         // Smoothed fraction of main-thread time spent busy
+    const char* reason;
+};
+
+/**
+ * @class QualityGovernor
+ * @brief Scales the expensive knobs up and down to hold a frame budget.
+ *
+ * Two signals come from the animation scheduler. The interval between
+ * presented frames shows when frames arrive late. The gaps between the
+ * scheduler's own short ticks show how busy the main thread is, since a tick
+ * can only run once the previous frame's work is done. The governor drops a
+ * level once frames have been late for kDowngradeSeconds, and only raises it
+ * again after load has stayed low for the much longer kUpgradeSeconds. Every
+ * change is followed by a cooldown, so it settles rather than oscillating
+ * between two levels.
+ */
+class QualityGovernor : public SchedulerListener {
+public:
+    static constexpr int kNumLevels = 5;
+    static constexpr int kMaxLevel = kNumLevels - 1;
+    static constexpr float kDefaultTargetFps = 60.0f;
+    static constexpr double kLateRatio = 1.2;        // Frames this much slower than budget are late
+    static constexpr double kLowLoad = 0.5;          // Below this the main thread has room for more
+    static constexpr double kDowngradeSeconds = 0.5;
+    static constexpr double kUpgradeSeconds = 4.0;
+    static constexpr double kCooldownSeconds = 2.0;
+    static constexpr double kMaxGapSeconds = 0.5;    // Longer gaps are pauses, not slow frames
+    static constexpr double kSmoothing = 0.1;
+    static constexpr int kMaxLogEntries = 64;
+
+    /**
+     * @brief Knob values for a level, from 0 (cheapest) to kMaxLevel. The top level uses the
+     *        original bloom size, border segments, node count and particle budget, with the
+     *        default spline tolerance.
+     */
+    static const QualitySettings& settings(int level) {
+        static const QualitySettings kLevels[kNumLevels] = {
+            { 0.0f, 4.0f, 48, 30, 40 },
+            { 16.0f, 2.0f, 80, 40, 80 },
+            { 24.0f, 1.0f, 120, 50, 120 },
+            { 32.0f, 0.5f, 160, 60, 160 },
+            { 40.0f, 0.25f, 200, 70, 200 },
+        };
+        return kLevels[std::min(std::max(level, 0), kMaxLevel)];
+    }
+
+    explicit QualityGovernor(AnimationScheduler& scheduler = AnimationScheduler::shared())
+        : scheduler_(scheduler), epoch_(Clock::now()) {
+        scheduler_.addListener(this);
+    }
+
+    ~QualityGovernor() override { scheduler_.removeListener(this); }
+
+    QualityGovernor(const QualityGovernor&) = delete;
+    QualityGovernor& operator=(const QualityGovernor&) = delete;
+
+    void setTargetFps(float fps) { budget_seconds_ = fps > 0.0f ? 1.0 / fps : 0.0; }
+
+    /** @brief A disabled governor holds its level; setLevel() still works. */
+    void setEnabled(bool enabled) { enabled_ = enabled; }
+    bool enabled() const { return enabled_; }
+
+    int level() const { return level_; }
+    const QualitySettings& currentSettings() const { return settings(level_); }
+
+    void setLevel(int level) { changeLevel(level, now(), "manual"); }
+
+    /** @brief Called with the new level and its settings after every change. */
+    std::function<void(int, const QualitySettings&)>& onLevelChanged() { return on_level_changed_; }
+
+    const std::deque<QualityDecision>& log() const { return log_; }
+    double frameMs() const { return frame_interval_ * 1000.0; }
+    double load() const { return load_; }
+
+    void schedulerTicked(const SchedulerStats& stats) override { update(now(), stats); }
+
+    /** @brief Feeds one scheduler tick observed at time seconds. */
+    void update(double time, const SchedulerStats& stats) {
+        // Gaps between fast ticks measure main-thread load; the idle poll and pauses say nothing.
+        if (last_tick_time_ >= 0.0 && !last_tick_idle_) {
+            double gap = time - last_tick_time_;
+            if (gap > 0.0 && gap < kMaxGapSeconds) {
+                double tick_seconds = AnimationScheduler::kTickMs / 1000.0;
+                double busy = std::max(0.0, gap - tick_seconds) / gap;
+                load_ += (busy - load_) * kSmoothing;
+            }
+        }
+        last_tick_time_ = time;
+        last_tick_idle_ = stats.idle;
+
+        if (!stats.ticked) return;
+        double budget = std::max(budget_seconds_, stats.frame_interval);
+        if (last_frame_time_ >= 0.0) {
+            double interval = time - last_frame_time_;
+            if (interval < kMaxGapSeconds)
+                frame_interval_ += (interval - frame_interval_) * kSmoothing;
+        }
+        last_frame_time_ = time;
+        if (!enabled_ || budget <= 0.0 || frame_interval_ <= 0.0) return;
+
+        bool late = frame_interval_ > budget * kLateRatio;
+        bool headroom = !late && load_ < kLowLoad;
+        late_since_ = late ? (late_since_ < 0.0 ? time : late_since_) : -1.0;
+        headroom_since_ = headroom ? (headroom_since_ < 0.0 ? time : headroom_since_) : -1.0;
+        if (time - last_change_time_ < kCooldownSeconds) return;
+
+        budget_ms_ = budget * 1000.0;
+        if (late && level_ > 0 && time - late_since_ >= kDowngradeSeconds)
+            changeLevel(level_ - 1, time, "frames late");
+        else if (headroom && level_ < kMaxLevel && time - headroom_since_ >= kUpgradeSeconds)
+            changeLevel(level_ + 1, time, "low load");
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double now() const { return std::chrono::duration<double>(Clock::now() - epoch_).count(); }
+
+    void changeLevel(int level, double time, const char* reason) {
+        level = std::min(std::max(level, 0), kMaxLevel);
+        if (level == level_) return;
+
+        log_.push_back({ time, level_, level, frameMs(), budget_ms_, load_, reason });
+        if (static_cast<int>(log_.size()) > kMaxLogEntries)
+            log_.pop_front();
+
+        level_ = level;
+        last_change_time_ = time;
+        late_since_ = -1.0;
+        headroom_since_ = -1.0;
+        if (on_level_changed_)
+            on_level_changed_(level_, settings(level_));
+    }
+
+    AnimationScheduler& scheduler_;
+    Clock::time_point epoch_;
+    std::function<void(int, const QualitySettings&)> on_level_changed_;
+    std::deque<QualityDecision> log_;
+    int level_ = kMaxLevel;
+    bool enabled_ = true;
+    double budget_seconds_ = 1.0 / kDefaultTargetFps;
+    double budget_ms_ = 1000.0 / kDefaultTargetFps;
+    double frame_interval_ = 0.0;
+    double load_ = 0.0;
+    double last_tick_time_ = -1.0;
+    bool last_tick_idle_ = true;
+    double last_frame_time_ = -1.0;
+    double late_since_ = -1.0;
+    double headroom_since_ = -1.0;
+    double last_change_time_ = -1e9;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @class FastRandom
+ * @brief Small seedable random number generator for per-emitter use.
+ *
+ * Four independent xoshiro128+ streams are kept side by side. Scalar calls draw
+ * from the first stream, and the fill functions step all four in lockstep, so the
+ * batch loops have no serial dependency and vectorize. Each emitter owns its own
+ * FastRandom, so nothing is shared between effects or threads, and the same seed
+ * always replays the same sequence.
+ */
+class FastRandom {
+public:
+    static constexpr int kLanes = 4;
+    static constexpr float kTwoPi = 6.2831853f;
+
+    explicit FastRandom(uint64_t seed = 0x853c49e6748fea9bULL) { setSeed(seed); }
+
+    /** @brief Restarts every stream from a seed; equal seeds give equal sequences. */
+    void setSeed(uint64_t seed) {
+        // splitmix64 spreads the seed over all the state words.
+        for (int lane = 0; lane < kLanes; ++lane) {
+            uint64_t a = splitMix(seed);
+            uint64_t b = splitMix(seed);
+            s0_[lane] = static_cast<uint32_t>(a);
+            s1_[lane] = static_cast<uint32_t>(a >> 32);
+            s2_[lane] = static_cast<uint32_t>(b);
+            s3_[lane] = static_cast<uint32_t>(b >> 32) | 1u; // Never all zero
+        }
+    }
+
+    uint32_t nextUint() { return step(0); }
+
+    /** @brief Uniform float in [0, 1). */
+    float nextFloat() { return toUnitFloat(step(0)); }
+
+    /** @brief Uniform float in [min, max). */
+    float uniform(float min, float max) { return min + nextFloat() * (max - min); }
+
+    /** @brief True with the given probability. */
+    bool chance(float probability) { return nextFloat() < probability; }
+
+    /** @brief Fills out with count uniform floats in [min, max). */
+    void fillUniform(float* out, int count, float min, float max) {
+        float range = max - min;
+        // Work on local copies of the lanes so the compiler keeps them in registers.
+        uint32_t s0[kLanes], s1[kLanes], s2[kLanes], s3[kLanes];
+        for (int lane = 0; lane < kLanes; ++lane) {
+            s0[lane] = s0_[lane];
+            s1[lane] = s1_[lane];
+            s2[lane] = s2_[lane];
+            s3[lane] = s3_[lane];
+        }
+
+        int i = 0;
+        for (; i + kLanes <= count; i += kLanes) {
+            for (int lane = 0; lane < kLanes; ++lane) {
+                uint32_t result = s0[lane] + s3[lane];
+                uint32_t t = s1[lane] << 9;
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = (s3[lane] << 11) | (s3[lane] >> 21);
+                out[i + lane] = min + static_cast<float>(static_cast<int32_t>(result >> 8)) * (range / 16777216.0f);
+            }
+        }
+
+        for (int lane = 0; lane < kLanes; ++lane) {
+            s0_[lane] = s0[lane];
+            s1_[lane] = s1[lane];
+            s2_[lane] = s2[lane];
+            s3_[lane] = s3[lane];
+        }
+        for (; i < count; ++i)
+            out[i] = min + nextFloat() * range;
+    }
+
+    /** @brief Fills out with count uniform angles in [0, 2pi). */
+    void fillAngles(float* out, int count) { fillUniform(out, count, 0.0f, kTwoPi); }
+
+private:
+    static uint64_t splitMix(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    // The top 24 bits fill a float mantissa exactly.
+    static float toUnitFloat(uint32_t x) { return static_cast<float>(x >> 8) * (1.0f / 16777216.0f); }
+
+    // One xoshiro128+ step of a single lane.
+    uint32_t step(int lane) {
+        uint32_t result = s0_[lane] + s3_[lane];
+        uint32_t t = s1_[lane] << 9;
+        s2_[lane] ^= s0_[lane];
+        s3_[lane] ^= s1_[lane];
+        s1_[lane] ^= s2_[lane];
+        s0_[lane] ^= s3_[lane];
+        s2_[lane] ^= t;
+        s3_[lane] = rotl(s3_[lane], 11);
+        return result;
+    }
+
+    uint32_t s0_[kLanes];
+    uint32_t s1_[kLanes];
+    uint32_t s2_[kLanes];
+    uint32_t s3_[kLanes];
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include "visage/ui.h"
+
+/**
+ * @class SharedBloom
+ * @brief One bloom pass for the whole app, run at the root over its HDR output.
+ *
+ * Frames no longer own a BloomPostEffect each. The bloom only picks up the part
+ * of a colour above HDR 1, so a frame sets how much it glows through the HDR it
+ * draws with. The effect is detached from the root whenever its size or
+ * intensity is zero, so a disabled bloom costs no offscreen buffer and no blur
+ * passes at all.
+ */
+class SharedBloom {
+public:
+    static constexpr float kDefaultSize = 40.0f;
+    static constexpr float kDefaultIntensity = 1.0f;
+
+    ~SharedBloom() { detach(); }
+
+    void attach(visage::Frame* root) {
+        detach();
+        root_ = root;
+        update();
+    }
+
+    void detach() {
+        if (root_ && active_)
+            root_->setPostEffect(nullptr);
+        root_ = nullptr;
+        active_ = false;
+    }
+
+    void setSize(float size) {
+        size_ = size;
+        update();
+    }
+
+    void setIntensity(float intensity) {
+        intensity_ = intensity;
+        update();
+    }
+
+    float size() const { return size_; }
+    float intensity() const { return intensity_; }
+
+    /** @brief False while the effect is skipped for having zero strength. */
+    bool active() const { return active_; }
+
+private:
+    void update() {
+        bloom_.setBloomSize(size_);
+        bloom_.setBloomIntensity(intensity_);
+        bool active = root_ && size_ > 0.0f && intensity_ > 0.0f;
+        if (active != active_ && root_)
+            root_->setPostEffect(active ? &bloom_ : nullptr);
+        active_ = active;
+        if (root_)
+            root_->redraw();
+    }
+
+    visage::BloomPostEffect bloom_;
+    visage::Frame* root_ = nullptr;
+    float size_ = kDefaultSize;
+    float intensity_ = kDefaultIntensity;
+    bool active_ = false;
+};
@@ -8,6 +8,14 @@
 #include <string>
 #include <chrono>
 #include "button.h"
+#include "stroke.h"
+#include "geometry_cache.h"
+#include "animation_scheduler.h"
+#include "layer_cache.h"
+#include "font_cache.h"
+#include "text_layout.h"
+#include "page_data.h"
+#include "boost.h"
 #include <iostream>
 #include <functional>
 #include <chrono>
@@ -30,6 +38,13 @@ public:
         // No special initialization needed.
     }
 
+    /**
+     * @brief The border geometry only depends on the frame size.
+     */
+    void resized() override {
+        geometry_.invalidate();
+    }
+
     /**
      * @brief The main drawing method, overridden from visage::Frame.
      * @param canvas The canvas object to draw on.
@@ -44,6 +59,20 @@ public:
             return;
         }
 
+        if (geometry_.needsRebuild(render_width, render_height)) {
+            buildGeometry(render_width, render_height);
+        }
+
+        // --- Drawing ---
+        // Set the static color for the border.
+        canvas.setColor(BORDER_COLOR);
+        geometry_.mesh().draw(canvas);
+        
+        // No redraw() call is needed as this is a static drawing.
+    }
+
+private:
+    void buildGeometry(int render_width, int render_height) {
         // --- Geometry Setup ---
         // Calculate the dimensions and position of the inner rectangle based on BORDER_SCALE.
         float scaled_width = render_width * BORDER_SCALE;
@@ -57,51 +86,26 @@ public:
         visage::Point p_br(margin_x + scaled_width, margin_y + scaled_height); // Bottom-Right
         visage::Point p_bl(margin_x, margin_y + scaled_height);               // Bottom-Left
 
-        // --- Drawing ---
-        // Set the static color for the border.
-        canvas.setColor(BORDER_COLOR);
-
-        // Draw the four sides of the rectangle.
-        drawThickLine(canvas, p_tl, p_tr, BORDER_THICKNESS); // Top
-        drawThickLine(canvas, p_tr, p_br, BORDER_THICKNESS); // Right
-        drawThickLine(canvas, p_br, p_bl, BORDER_THICKNESS); // Bottom
-        drawThickLine(canvas, p_bl, p_tl, BORDER_THICKNESS); // Left
-        
-        // No redraw() call is needed as this is a static drawing.
+        // The four sides form one closed stroke so the corners are mitered.
+        visage::Point corners[4] = { p_tl, p_tr, p_br, p_bl };
+        geometry_.mesh().clear();
+        geometry_.mesh().addPolyline(corners, 4, true, BORDER_THICKNESS);
+        geometry_.markBuilt(render_width, render_height);
     }
 
-private:
-    /**
-     * @brief Draws a thick line by constructing a quadrilateral (as two triangles).
-     * @param canvas The canvas to draw on.
-     * @param p1 The starting point of the line.
-     * @param p2 The ending point of the line.
-     * @param thickness The desired thickness of the line.
-     */
-    void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-        visage::Point delta = p2 - p1;
-        float length = sqrt(delta.x * delta.x + delta.y * delta.y);
-
-        // Don't draw if the line has no length.
-        if (length < 1e-6f) return;
-
-        // Calculate the perpendicular vector and scale it by half the thickness.
-        visage::Point perp(-delta.y / length, delta.x / length);
-        float half_thickness = thickness / 2.0f;
-
-        // Calculate the 4 vertices of the thick line's rectangle.
-        visage::Point v1 = p1 + perp * half_thickness;
-        visage::Point v2 = p2 + perp * half_thickness;
-        visage::Point v3 = p2 - perp * half_thickness;
-        visage::Point v4 = p1 - perp * half_thickness;
-
-        // Draw the rectangle as two triangles.
-        canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-        canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
-    }
+    StrokeGeometryCache geometry_;
 };
 
 
+/**
+ * @class AnimatedBorder
+ * @brief The silver loop around the page with two travelling boosts.
+ *
+ * The border frame itself draws nothing. Its four edges are child frames just
+ * wide enough for the stroke, and only they are registered with the scheduler,
+ * so an animating border re-rasterizes a thin ring instead of the whole canvas.
+ * The edges share one stroke mesh; each draws the segments that reach into it.
+ */
 class AnimatedBorder : public visage::Frame {
 public:
     // --- Configuration Constants ---
@@ -111,29 +115,104 @@ public:
     static constexpr float BOOSTED_THICKNESS_ADDITION = 2.5f;  // How much thickness the boost effect adds.
     static constexpr float BOOST_SPEED_MULTIPLIER = 0.3f;      // Controls the speed of the animation.
     static constexpr float BOOST_INTENSITY_MULTIPLIER = 2.0f;  // How much brighter the boosted section gets.
+    static constexpr float BLOOM_STRENGTH = 0.0f;              // The border sits outside any bloom; keep its HDR at 1.
+    static constexpr float BOOST_FALLOFF = 20.0f;              // Larger values make the boost shorter; 20 spans 0.1 of the loop.
+    static constexpr int kNumSegments = 200;                   // Default segment count; more = smoother animation.
+    static constexpr float kEdgeReach = 8.0f;                  // Edge frames extend this far either side of the line.
+    static constexpr int kNumEdges = 4;
     const visage::Color BASE_COLOR = 0xFFC0C0C0;             // Silver color for the border.
 
     /**
      * @brief Default constructor.
      */
     AnimatedBorder() {
-        // Initialization is handled within the draw method.
+        for (Edge& edge : edges_)
+            addChild(&edge);
     }
 
     /**
-     * @brief The main drawing method, overridden from visage::Frame.
-     * @param canvas The canvas object to draw on.
+     * @brief The perimeter geometry only depends on the frame size; the edges
+     *        follow the scaled rectangle.
      */
-    void draw(visage::Canvas& canvas) override {
-        // --- Get frame and time properties ---
-        double render_time = canvas.time();
+    void resized() override {
+        geometry_.invalidate();
+
+        float scaled_width = width() * BORDER_SCALE;
+        float scaled_height = height() * BORDER_SCALE;
+        float left = (width() - scaled_width) / 2.0f - kEdgeReach;
+        float top = (height() - scaled_height) / 2.0f - kEdgeReach;
+        float across = scaled_width + 2.0f * kEdgeReach;
+        float band = 2.0f * kEdgeReach;
+        float down = std::max(scaled_height - band, 0.0f);
+        edges_[0].setBounds(left, top, across, band);                      // Top
+        edges_[1].setBounds(left + across - band, top + band, band, down); // Right
+        edges_[2].setBounds(left, top + band + down, across, band);        // Bottom
+        edges_[3].setBounds(left, top + band, band, down);                 // Left
+    }
+
+    /**
+     * @brief Sets how many segments the perimeter is sampled into; used by the
+     *        quality governor.
+     */
+    void setNumSegments(int num_segments) {
+        num_segments = std::max(num_segments, 4);
+        if (num_segments == num_segments_) return;
+        num_segments_ = num_segments;
+        geometry_.invalidate();
+    }
+
+    int numSegments() const { return num_segments_; }
+
+    /** @brief The frames that show the border; the scheduler redraws these, not the border. */
+    visage::Frame& edge(int index) { return edges_[index]; }
+
+private:
+    // One side of the loop, drawing the shared mesh's segments that reach into its bounds.
+    class Edge : public visage::Frame {
+    public:
+        explicit Edge(AnimatedBorder& border) : border_(border) {}
+
+        void draw(visage::Canvas& canvas) override { border_.drawEdge(canvas, *this); }
+
+        std::vector<int> segments;
+
+    private:
+        AnimatedBorder& border_;
+        ScheduledAnimation animation_{ this };
+    };
+
+    void drawEdge(visage::Canvas& canvas, const Edge& edge) {
+        if (!prepare(canvas.time()) || edge.segments.empty()) {
+            return;
+        }
+        geometry_.mesh().drawHdr(canvas, BASE_COLOR, hdr_.data(), edge.segments.data(),
+                                 static_cast<int>(edge.segments.size()),
+                                 visage::Point(edge.bounds().x(), edge.bounds().y()));
+    }
+
+    // Rebuilds the geometry after a resize and sets the boosts for render_time, once per
+    // frame however many edges draw. False if there is nothing to draw.
+    bool prepare(double render_time) {
         int render_height = height();
         int render_width = width();
 
         // Avoid drawing if the frame is too small to prevent visual glitches.
         if (render_width < 10 || render_height < 10) {
-            return;
+            return false;
+        }
+
+        if (geometry_.needsRebuild(render_width, render_height)) {
+            buildGeometry(render_width, render_height);
+            prepared_time_ = -1.0;
+        }
+        StrokeMesh& mesh = geometry_.mesh();
+        if (mesh.numSegments() == 0) {
+            return false;
+        }
+        if (render_time == prepared_time_) {
+            return true;
         }
+        prepared_time_ = render_time;
 
         // --- Animation Parameters for TWO boosts ---
         float boost_time = render_time * BOOST_SPEED_MULTIPLIER;
@@ -142,6 +221,30 @@ public:
         // Phase 2 moves backward (1 to 0)
         float boost_phase_2 = 1.0f - boost_phase_1;
 
+        // --- Apply COMBINED Boost Effect ---
+        // One boost travels clockwise, the other counter-clockwise; the final boost is the
+        // maximum of the two.
+        const float* params = geometry_.params().data();
+        int num_segments = static_cast<int>(geometry_.params().size());
+        boosts_.resize(num_segments);
+        second_boosts_.resize(num_segments);
+        thicknesses_.resize(num_segments);
+        hdr_.resize(num_segments);
+        computeWrappedBoosts(params, num_segments, fmod(boost_phase_1 + start_offset_, 1.0f),
+                             BOOST_FALLOFF, boosts_.data());
+        computeWrappedBoosts(params, num_segments, fmod(boost_phase_2 + start_offset_, 1.0f),
+                             BOOST_FALLOFF, second_boosts_.data());
+        maxBoosts(boosts_.data(), second_boosts_.data(), num_segments);
+        scaleBoosts(boosts_.data(), num_segments, BASE_THICKNESS, BOOSTED_THICKNESS_ADDITION, thicknesses_.data());
+        scaleBoosts(boosts_.data(), num_segments, 1.0f, BOOST_INTENSITY_MULTIPLIER * BLOOM_STRENGTH, hdr_.data());
+
+        mesh.setThicknesses(thicknesses_.data());
+        return true;
+    }
+
+    void buildGeometry(int render_width, int render_height) {
+        geometry_.mesh().clear();
+        geometry_.markBuilt(render_width, render_height);
 
         // --- Geometry Setup ---
         float scaled_width = render_width * BORDER_SCALE;
@@ -167,100 +270,67 @@ public:
         
         // --- Set animation start point to top-center ---
         // The proportional distance to the middle of the top edge.
-        float start_offset = top_prop / 2.0f;
-
-        // --- Drawing Loop ---
-        visage::Point last_point = p_tl;
-        const int kNumSegments = 200; // More segments = smoother animation.
-
-        for (int i = 0; i <= kNumSegments; ++i) { // Use <= to ensure the loop closes
-            float t = static_cast<float>(i) / kNumSegments;
-            visage::Point current_point;
+        start_offset_ = top_prop / 2.0f;
+
+        // --- Sample the perimeter ---
+        // The sample at t = 1 lands back on the first point, so the loop is closed by the stroke.
+        std::vector<visage::Point>& points = geometry_.points();
+        std::vector<float>& params = geometry_.params();
+        points.resize(num_segments_);
+        params.resize(num_segments_);
+        for (int i = 0; i < num_segments_; ++i) {
+            float t = static_cast<float>(i) / num_segments_;
+            params[i] = t;
 
             // Determine which edge the current point is on.
             if (t <= top_prop) {
                 float local_t = t / top_prop;
-                current_point = p_tl + (p_tr - p_tl) * local_t;
+                points[i] = p_tl + (p_tr - p_tl) * local_t;
             } else if (t <= top_prop + right_prop) {
                 float local_t = (t - top_prop) / right_prop;
-                current_point = p_tr + (p_br - p_tr) * local_t;
+                points[i] = p_tr + (p_br - p_tr) * local_t;
             } else if (t <= top_prop + right_prop + bottom_prop) {
                 float local_t = (t - (top_prop + right_prop)) / bottom_prop;
-                current_point = p_br + (p_bl - p_br) * local_t;
+                points[i] = p_br + (p_bl - p_br) * local_t;
             } else {
                 float local_t = (t - (top_prop + right_prop + bottom_prop)) / (1.0f - (top_prop + right_prop + bottom_prop));
-                current_point = p_bl + (p_tl - p_bl) * local_t;
+                points[i] = p_bl + (p_tl - p_bl) * local_t;
             }
-            
-            // For the very first point, just set last_point and continue.
-            if (i == 0) {
-                last_point = current_point;
-                continue;
-            }
-
-            // --- Apply COMBINED Boost Effect ---
-            // Calculate boost from the first path (clockwise).
-            float boost1 = compute_boost(t - fmod(boost_phase_1 + start_offset, 1.0f));
-            // Calculate boost from the second path (counter-clockwise).
-            float boost2 = compute_boost(t - fmod(boost_phase_2 + start_offset, 1.0f));
-            // The final boost is the maximum of the two.
-            float current_boost = std::max(boost1, boost2);
-
-            visage::Color boostedColor = BASE_COLOR;
-            boostedColor.setHdr(1.0f + current_boost * BOOST_INTENSITY_MULTIPLIER);
-            canvas.setColor(boostedColor);
-
-            float current_thickness = BASE_THICKNESS + current_boost * BOOSTED_THICKNESS_ADDITION;
-            drawThickLine(canvas, last_point, current_point, current_thickness);
-
-            last_point = current_point;
         }
 
-        redraw();
+        geometry_.mesh().addPolyline(points.data(), num_segments_, true, BASE_THICKNESS);
+        assignEdgeSegments();
     }
 
-private:
-    /**
-     * @brief Computes the boost amount based on distance from the peak.
-     * @param dist The normalized distance from the peak of the boost.
-     * @return A value from 0.0 to 1.0 representing the boost intensity.
-     */
-    static float compute_boost(float dist) {
-        // Wrap the distance to the range [-0.5, 0.5] to handle the loop correctly.
-        dist = dist - floorf(dist);
-        if (dist > 0.5f) {
-            dist -= 1.0f;
+    // Each edge draws every segment whose stroke, at its boosted width, can reach into it.
+    void assignEdgeSegments() {
+        const std::vector<visage::Point>& points = geometry_.points();
+        int num_points = static_cast<int>(points.size());
+        for (Edge& edge : edges_) {
+            edge.segments.clear();
+            float left = edge.bounds().x() - kEdgeReach;
+            float top = edge.bounds().y() - kEdgeReach;
+            float right = edge.bounds().x() + edge.bounds().width() + kEdgeReach;
+            float bottom = edge.bounds().y() + edge.bounds().height() + kEdgeReach;
+            for (int i = 0; i < num_points; ++i) {
+                visage::Point a = points[i];
+                visage::Point b = points[(i + 1) % num_points];
+                if (std::max(a.x, b.x) > left && std::min(a.x, b.x) < right && std::max(a.y, b.y) > top &&
+                    std::min(a.y, b.y) < bottom)
+                    edge.segments.push_back(i);
+            }
         }
-        // This creates a triangle wave that peaks at dist=0 and has a configurable width.
-        // A larger multiplier (e.g., 20.0f) makes the boost shorter and more focused.
-        // A multiplier of 20.0f gives the boost a total "width" of 0.1 on the 0-1 scale.
-        return std::max(0.0f, 1.0f - std::abs(dist) * 20.0f);
     }
 
-    /**
-     * @brief Draws a thick line by constructing a quadrilateral (as two triangles).
-     * @param canvas The canvas to draw on.
-     * @param p1 The starting point of the line.
-     * @param p2 The ending point of the line.
-     * @param thickness The desired thickness of the line.
-     */
-    void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-        visage::Point delta = p2 - p1;
-        float length = sqrt(delta.x * delta.x + delta.y * delta.y);
-
-        if (length < 1e-6f) return;
-
-        visage::Point perp(-delta.y / length, delta.x / length);
-        float half_thickness = thickness / 2.0f;
-
-        visage::Point v1 = p1 + perp * half_thickness;
-        visage::Point v2 = p2 + perp * half_thickness;
-        visage::Point v3 = p2 - perp * half_thickness;
-        visage::Point v4 = p1 - perp * half_thickness;
-
-        canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-        canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
-    }
+    StrokeGeometryCache geometry_;
+    int num_segments_ = kNumSegments;
+    float start_offset_ = 0.0f;
+    std::vector<float> boosts_;
+    std::vector<float> second_boosts_;
+    std::vector<float> thicknesses_;
+    std::vector<float> hdr_;
+    double prepared_time_ = -1.0;
+    Edge edges_[kNumEdges] = { Edge(*this), Edge(*this), Edge(*this), Edge(*this) };
 };
 
 
@@ -288,311 +358,50 @@ private:
 
 };
 
-class MySimpleFrame : public visage::Frame { // Inherit directly from visage::Frame
+/**
+ * @class SlidePage
+ * @brief The translucent panel and text of one slide, drawn from a PageData.
+ *
+ * Text sizes and positions are fractions of the reference height given at
+ * construction. Each run keeps its TextLayout, so the text is laid out when
+ * the page is first drawn at a size and then reused.
+ */
+class SlidePage : public visage::Frame {
 public:
-    MySimpleFrame(int _width = 800, int _height = 600) {
+    SlidePage(int _width = 800, int _height = 600) {
         m_width = _width;
         m_height = _height;
-        // setIgnoresMouseEvents(false, false); // Allow mouse events to be processed
-        // setFlexLayout(true);
-        // layout().setPadding(10);
-        // layout().setFlexGap(10);
-
-        // addChild(&previous_button_);
-        // addChild(&next_button_);
-
-        // // Positioning for Previous button (bottom-left)
-        // // Set a small margin from the left edge
-        // previous_button_.layout().setMarginLeft(m_width * 0.05f);
-        // previous_button_.layout().setMarginTop(m_height * 0.6f);
-        // // Set its width and height
-        // previous_button_.layout().setWidth(m_width * 0.15f);
-        // previous_button_.layout().setHeight(m_height * 0.07f);
-
-
-        // // Positioning for Next button (bottom-right)
-        // // Use marginLeft with a large value to push it to the right.
-        // // This effectively creates a space between the previous button and itself.
-        // next_button_.layout().setMarginLeft(m_width * 0.1f); // Adjust this value to control spacing from left button
-        // next_button_.layout().setMarginTop(m_height * 0.3f);
-        // // Set its width and height
-        // next_button_.layout().setWidth(m_width * 0.15f);
-        // next_button_.layout().setHeight(m_height * 0.07f);
-
-        // Set the background color to white
-        onDraw() = [&](visage::Canvas& canvas) {
-            //canvas.setColor(0xFFFFFFFF); // White color (ARGB: Alpha, Red, Green, Blue)
-            canvas.setColor(0x80000000);
-            canvas.roundedRectangle(0, 0, width(), height(), 4); // No rounded corners for a simple rectangle
-            
-            // Draw the text
-            visage::Font myFont(16, visage::fonts::Lato_Regular_ttf);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            // You can adjust the justification and position as needed
-            // canvas.text(m_welcome_message, myFont, visage::Font::Justification::kCenter, 0, 0, width(), height());
-                        // Draw the title "GPU Accelerated Website In C++"
-            visage::Font titleFont(static_cast<int>(m_height * 0.05), visage::fonts::Lato_Regular_ttf);
-            int fontHeight = static_cast<int>(m_height * 0.05);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            canvas.text("Welcome!", titleFont, visage::Font::Justification::kCenter, 0, m_height * 0.1f, width(), fontHeight);
-
-            // // Draw the smaller font description "hello my name is Skyler crank and I am applying to nvidia"
-            visage::Font descFont(static_cast<int>(m_height * 0.03), visage::fonts::Lato_Regular_ttf);
-            int descfontHeight = static_cast<int>(m_height * 0.03);
-            canvas.text("What you are seeing is a Hardware Accelerated Website In C++.", descFont, visage::Font::Justification::kCenter, 0, m_height * 0.2f, width(), descfontHeight);
-
-            // Draw Job ID in bottom-left
-            int idFontHeight = static_cast<int>(m_height * 0.025);
-            visage::Font jobIdFont(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("Programmed directly from your GPU to your screen.", jobIdFont, visage::Font::Justification::kCenter, 0, m_height * 0.3f, width(), idFontHeight);
-
-            visage::Font jobIdFont2(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("Page 1 / 4", jobIdFont2, visage::Font::Justification::kCenter, 0, m_height * 0.7f, width(), idFontHeight);
-
 
-        };
-    }
-
-    void set_frames(int width_, int height_) {
-        layout().setWidth(width_);
-        layout().setHeight(height_);
-        redraw(); // Request a redraw to apply the new size
-    }
-
-    int m_width = 800;
-    int m_height = 600;
-private:
-    std::string m_welcome_message = "Built entirely with C++, this website utilizes a hardware-accelerated GPU to program straight to your browser.";
-    Button previous_button_;
-    Button next_button_;
-};
-
-class MySimpleFrame1 : public visage::Frame { // Inherit directly from visage::Frame
-public:
-    MySimpleFrame1(int _width = 800, int _height = 600) {
-        m_width = _width;
-        m_height = _height;
-        // setIgnoresMouseEvents(false, false); // Allow mouse events to be processed
-        // setFlexLayout(true);
-        // layout().setPadding(10);
-        // layout().setFlexGap(10);
-
-        // addChild(&previous_button_);
-        // addChild(&next_button_);
-
-        // // Positioning for Previous button (bottom-left)
-        // // Set a small margin from the left edge
-        // previous_button_.layout().setMarginLeft(m_width * 0.05f);
-        // previous_button_.layout().setMarginTop(m_height * 0.6f);
-        // // Set its width and height
-        // previous_button_.layout().setWidth(m_width * 0.15f);
-        // previous_button_.layout().setHeight(m_height * 0.07f);
-
-
-        // // Positioning for Next button (bottom-right)
-        // // Use marginLeft with a large value to push it to the right.
-        // // This effectively creates a space between the previous button and itself.
-        // next_button_.layout().setMarginLeft(m_width * 0.1f); // Adjust this value to control spacing from left button
-        // next_button_.layout().setMarginTop(m_height * 0.3f);
-        // // Set its width and height
-        // next_button_.layout().setWidth(m_width * 0.15f);
-        // next_button_.layout().setHeight(m_height * 0.07f);
-
-        // Set the background color to white
         onDraw() = [&](visage::Canvas& canvas) {
-            canvas.setColor(0x80000000); // White color (ARGB: Alpha, Red, Green, Blue)
-            canvas.roundedRectangle(0, 0, width(), height(), 4); // No rounded corners for a simple rectangle
-            
-            // Draw the text
-            visage::Font myFont(16, visage::fonts::Lato_Regular_ttf);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            // You can adjust the justification and position as needed
-            // canvas.text(m_welcome_message, myFont, visage::Font::Justification::kCenter, 0, 0, width(), height());
-                        // Draw the title "GPU Accelerated Website In C++"
-            visage::Font titleFont(static_cast<int>(m_height * 0.05), visage::fonts::Lato_Regular_ttf);
-            int fontHeight = static_cast<int>(m_height * 0.05);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            canvas.text("My name is Skyler Crank", titleFont, visage::Font::Justification::kCenter, 0, m_height * 0.1f, width(), fontHeight);
-
-            // // Draw the smaller font description "hello my name is Skyler crank and I am applying to nvidia"
-            visage::Font descFont(static_cast<int>(m_height * 0.03), visage::fonts::Lato_Regular_ttf);
-            int descfontHeight = static_cast<int>(m_height * 0.03);
-            canvas.text("I am applying for Senior DevOps Engineer", descFont, visage::Font::Justification::kCenter, 0, m_height * 0.2f, width(), descfontHeight);
-
-            // Draw Job ID in bottom-left
-            int idFontHeight = static_cast<int>(m_height * 0.025);
-            visage::Font jobIdFont(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("Job ID JR1997172", jobIdFont, visage::Font::Justification::kCenter, 0, m_height * 0.3f, width(), idFontHeight);
-
-            visage::Font jobIdFont2(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("Page 2 / 4", jobIdFont2, visage::Font::Justification::kCenter, 0, m_height * 0.7f, width(), idFontHeight);
-
-
-        };
-    }
-
-    void set_frames(int width_, int height_) {
-        layout().setWidth(width_);
-        layout().setHeight(height_);
-        redraw(); // Request a redraw to apply the new size
-    }
-
-    int m_width = 800;
-    int m_height = 600;
-private:
-    std::string m_welcome_message = "Built entirely with C++, this website utilizes a hardware-accelerated GPU to program straight to your browser.";
-    Button previous_button_;
-    Button next_button_;
-};
-
-
-
-class MySimpleFrame2 : public visage::Frame { // Inherit directly from visage::Frame
-public:
-    MySimpleFrame2(int _width = 800, int _height = 600) {
-        m_width = _width;
-        m_height = _height;
-        // setIgnoresMouseEvents(false, false); // Allow mouse events to be processed
-        // setFlexLayout(true);
-        // layout().setPadding(10);
-        // layout().setFlexGap(10);
-
-        // addChild(&previous_button_);
-        // addChild(&next_button_);
-
-        // // Positioning for Previous button (bottom-left)
-        // // Set a small margin from the left edge
-        // previous_button_.layout().setMarginLeft(m_width * 0.05f);
-        // previous_button_.layout().setMarginTop(m_height * 0.6f);
-        // // Set its width and height
-        // previous_button_.layout().setWidth(m_width * 0.15f);
-        // previous_button_.layout().setHeight(m_height * 0.07f);
-
-
-        // // Positioning for Next button (bottom-right)
-        // // Use marginLeft with a large value to push it to the right.
-        // // This effectively creates a space between the previous button and itself.
-        // next_button_.layout().setMarginLeft(m_width * 0.1f); // Adjust this value to control spacing from left button
-        // next_button_.layout().setMarginTop(m_height * 0.3f);
-        // // Set its width and height
-        // next_button_.layout().setWidth(m_width * 0.15f);
-        // next_button_.layout().setHeight(m_height * 0.07f);
-
-        // Set the background color to white
-        onDraw() = [&](visage::Canvas& canvas) {
-            //canvas.setColor(0xFFFFFFFF); // White color (ARGB: Alpha, Red, Green, Blue)
+            layer_.noteRendered();
             canvas.setColor(0x80000000);
-            canvas.roundedRectangle(0, 0, width(), height(), 4); // No rounded corners for a simple rectangle
-            
-            // Draw the text
-            visage::Font myFont(16, visage::fonts::Lato_Regular_ttf);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            // You can adjust the justification and position as needed
-            // canvas.text(m_welcome_message, myFont, visage::Font::Justification::kCenter, 0, 0, width(), height());
-                        // Draw the title "GPU Accelerated Website In C++"
-            visage::Font titleFont(static_cast<int>(m_height * 0.05), visage::fonts::Lato_Regular_ttf);
-            int fontHeight = static_cast<int>(m_height * 0.05);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            canvas.text("Experience", titleFont, visage::Font::Justification::kCenter, 0, m_height * 0.1f, width(), fontHeight);
-
-            // // Draw the smaller font description "hello my name is Skyler crank and I am applying to nvidia"
-            visage::Font descFont(static_cast<int>(m_height * 0.03), visage::fonts::Lato_Regular_ttf);
-            int descfontHeight = static_cast<int>(m_height * 0.03);
-            canvas.text("10 Years C++ (CMake)", descFont, visage::Font::Justification::kCenter, 0, m_height * 0.2f, width(), descfontHeight);
-
-            // Draw Job ID in bottom-left
-            int idFontHeight = static_cast<int>(m_height * 0.03);
-            visage::Font jobIdFont(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("3 Years Python", jobIdFont, visage::Font::Justification::kCenter, 0, m_height * 0.3f, width(), idFontHeight);
-
-                        // Draw Job ID in bottom-left
-            // int idFontHeight = static_cast<int>(m_height * 0.025);
-            visage::Font jobIdFont1(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("7 Years Linux (Ubuntu) (Red-Hat)", jobIdFont1, visage::Font::Justification::kCenter, 0, m_height * 0.4f, width(), idFontHeight);
-
-            visage::Font jobIdFont2(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("Page 3 / 4", jobIdFont2, visage::Font::Justification::kCenter, 0, m_height * 0.7f, width(), idFontHeight);
-
+            canvas.roundedRectangle(0, 0, width(), height(), 4);
 
+            canvas.setColor(0xFFFFFFFF);
+            for (Run& run : runs_) {
+                int font_height = static_cast<int>(m_height * run.size);
+                const visage::Font& font = FontCache::shared().get(font_height);
+                run.layout.draw(canvas, font, 0, m_height * run.y, width(), font_height);
+            }
         };
-    }
 
-    void set_frames(int width_, int height_) {
-        layout().setWidth(width_);
-        layout().setHeight(height_);
-        redraw(); // Request a redraw to apply the new size
+        // The panel only changes on resize, so it is drawn once and then composited.
+        layer_.attach(this);
     }
 
-    int m_width = 800;
-    int m_height = 600;
-private:
-    std::string m_welcome_message = "Built entirely with C++, this website utilizes a hardware-accelerated GPU to program straight to your browser.";
-    Button previous_button_;
-    Button next_button_;
-};
-
-
-class MySimpleFrame3 : public visage::Frame { // Inherit directly from visage::Frame
-public:
-    MySimpleFrame3(int _width = 800, int _height = 600) {
-        m_width = _width;
-        m_height = _height;
-        // setIgnoresMouseEvents(false, false); // Allow mouse events to be processed
-        // setFlexLayout(true);
-        // layout().setPadding(10);
-        // layout().setFlexGap(10);
-
-        // addChild(&previous_button_);
-        // addChild(&next_button_);
-
-        // // Positioning for Previous button (bottom-left)
-        // // Set a small margin from the left edge
-        // previous_button_.layout().setMarginLeft(m_width * 0.05f);
-        // previous_button_.layout().setMarginTop(m_height * 0.6f);
-        // // Set its width and height
-        // previous_button_.layout().setWidth(m_width * 0.15f);
-        // previous_button_.layout().setHeight(m_height * 0.07f);
-
-
-        // // Positioning for Next button (bottom-right)
-        // // Use marginLeft with a large value to push it to the right.
-        // // This effectively creates a space between the previous button and itself.
-        // next_button_.layout().setMarginLeft(m_width * 0.1f); // Adjust this value to control spacing from left button
-        // next_button_.layout().setMarginTop(m_height * 0.3f);
-        // // Set its width and height
-        // next_button_.layout().setWidth(m_width * 0.15f);
-        // next_button_.layout().setHeight(m_height * 0.07f);
-
-        // Set the background color to white
-        onDraw() = [&](visage::Canvas& canvas) {
-            canvas.setColor(0x80000000); // White color (ARGB: Alpha, Red, Green, Blue)
-            canvas.roundedRectangle(0, 0, width(), height(), 4); // No rounded corners for a simple rectangle
-            
-            // Draw the text
-            visage::Font myFont(16, visage::fonts::Lato_Regular_ttf);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            // You can adjust the justification and position as needed
-            // canvas.text(m_welcome_message, myFont, visage::Font::Justification::kCenter, 0, 0, width(), height());
-                        // Draw the title "GPU Accelerated Website In C++"
-            visage::Font titleFont(static_cast<int>(m_height * 0.05), visage::fonts::Lato_Regular_ttf);
-            int fontHeight = static_cast<int>(m_height * 0.05);
-            canvas.setColor(0xFFFFFFFF); // Black color for the text
-            canvas.text("Thank you!", titleFont, visage::Font::Justification::kCenter, 0, m_height * 0.1f, width(), fontHeight);
-
-            // // // Draw the smaller font description "hello my name is Skyler crank and I am applying to nvidia"
-            visage::Font descFont(static_cast<int>(m_height * 0.03), visage::fonts::Lato_Regular_ttf);
-            int descfontHeight = static_cast<int>(m_height * 0.03);
-            canvas.text("If you want to see more of my work, check out", descFont, visage::Font::Justification::kCenter, 0, m_height * 0.2f, width(), descfontHeight);
-
-            // // Draw Job ID in bottom-left
-            int idFontHeight = static_cast<int>(m_height * 0.03);
-            visage::Font jobIdFont(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("www.SkylerCrank.com", jobIdFont, visage::Font::Justification::kCenter, 0, m_height * 0.3f, width(), idFontHeight);
-
-            visage::Font jobIdFont2(idFontHeight, visage::fonts::Lato_Regular_ttf);
-            canvas.text("Page 4 / 4", jobIdFont2, visage::Font::Justification::kCenter, 0, m_height * 0.7f, width(), idFontHeight);
+    void setPage(const PageData& page) {
+        runs_.clear();
+        runs_.reserve(page.runs.size());
+        for (const PageRun& run : page.runs)
+            runs_.push_back({ TextLayout(run.text), run.size, run.y });
+        layer_.invalidate();
+    }
 
-        };
+    /** @brief Sets the size text is scaled against, normally the canvas size. */
+    void setReferenceSize(int width_, int height_) {
+        m_width = width_;
+        m_height = height_;
+        layer_.invalidate();
     }
 
     void set_frames(int width_, int height_) {
@@ -604,7 +413,12 @@ public:
     int m_width = 800;
     int m_height = 600;
 private:
-    std::string m_welcome_message = "Built entirely with C++, this website utilizes a hardware-accelerated GPU to program straight to your browser.";
-    Button previous_button_;
-    Button next_button_;
+    struct Run {
+        TextLayout layout;
+        float size;
+        float y;
+    };
+
+    std::vector<Run> runs_;
+    CachedLayer layer_;
 };
\ No newline at end of file
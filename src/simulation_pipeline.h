@@ -0,0 +1,274 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include "embedded/fonts.h"
+#include "font_cache.h"
+#include "worker_pool.h" // For HIRE_ME_HAS_THREADS
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <utility>
+#include <algorithm> // For std::min/max
+
+#if HIRE_ME_HAS_THREADS
+#include <thread>
+#endif
+#include <atomic>
+
+/**
+ * @brief Timing for a running SimulationPipeline, smoothed over recent frames.
+ */
+struct PipelineStats {
+    double simulation_ms = 0.0;  // Time spent in one simulation step
+    double render_ms = 0.0;      // Time spent drawing one frame
+    int steps_per_second = 0;    // Simulation steps completed in the last second
+    int dropped_snapshots = 0;   // Snapshots replaced before the renderer picked them up
+    bool threaded = false;       // False when the steps run inline on the render thread
+};
+
+/** @brief Pipeline threads running across the app, whatever their simulation type. */
+inline std::atomic<int>& simulationPipelineThreads() {
+    static std::atomic<int> num_threads{ 0 };
+    return num_threads;
+}
+
+/**
+ * @class SimulationPipeline
+ * @brief Runs a simulation at a fixed timestep, decoupled from rendering.
+ *
+ * Simulation must provide step(float dt) and capture(Snapshot&) const. While
+ * the pipeline is running, a dedicated thread steps it every stepSeconds() and
+ * captures each result into a back buffer. The back buffer is then exchanged
+ * with a shared middle slot. The renderer holds two more buffers, the previous
+ * and current snapshot, and update() swaps a fresh middle slot in. Only buffer
+ * indices change hands under the lock, so stepping and drawing overlap and
+ * neither waits on the other. draw() renders update()'s alpha between
+ * previous() and current(), trailing the simulation by one step.
+ *
+ * At most kMaxThreads pipelines have a thread at once, so together with the
+ * WorkerPool they never outnumber the web workers the wasm build preallocates.
+ * Without thread support, or once that many are running, running() still
+ * holds, but update() performs the due steps inline before it swaps, so
+ * callers need no separate code path.
+ */
+template <typename Simulation, typename Snapshot>
+class SimulationPipeline {
+public:
+    static constexpr double kDefaultStepSeconds = 1.0 / 120.0;
+    static constexpr int kMaxCatchUpSteps = 8; // Past this the simulation slows down instead of spiralling
+    static constexpr int kMaxThreads = WorkerPool::kReservedThreads; // Across every pipeline in the app
+
+    explicit SimulationPipeline(double step_seconds = kDefaultStepSeconds) : step_seconds_(step_seconds) {}
+    ~SimulationPipeline() { stop(); }
+
+    SimulationPipeline(const SimulationPipeline&) = delete;
+    SimulationPipeline& operator=(const SimulationPipeline&) = delete;
+
+    /** @brief Direct access for set-up; only safe while the pipeline is stopped. */
+    Simulation& simulation() { return simulation_; }
+
+    /** @brief Runs fn(simulation) between two steps. Safe at any time. */
+    template <typename Function>
+    void modify(Function fn) {
+        std::lock_guard<std::mutex> lock(simulation_mutex_);
+        fn(simulation_);
+    }
+
+    void start() {
+        if (running_) return;
+        epoch_ = Clock::now();
+        simulation_time_ = 0.0;
+        next_step_time_ = step_seconds_;
+        {
+            std::lock_guard<std::mutex> lock(simulation_mutex_);
+            simulation_.capture(buffers_[previous_]);
+            simulation_.capture(buffers_[current_]);
+        }
+        times_[previous_] = 0.0;
+        times_[current_] = 0.0;
+        fresh_ = false;
+        running_ = true;
+
+#if HIRE_ME_HAS_THREADS
+        threaded_ = acquireThread();
+        if (threaded_) {
+            stopping_ = false;
+            thread_ = std::thread([this] { threadLoop(); });
+        }
+#endif
+    }
+
+    void stop() {
+        if (!running_) return;
+#if HIRE_ME_HAS_THREADS
+        if (threaded_) {
+            stopping_ = true;
+            thread_.join();
+            releaseThread();
+        }
+#endif
+        threaded_ = false;
+        running_ = false;
+    }
+
+    bool running() const { return running_; }
+    double stepSeconds() const { return step_seconds_; }
+
+    /**
+     * @brief Picks up the newest snapshot and returns how far the render time
+     *        lies between previous() and current(), from 0 to 1.
+     */
+    float update() {
+        double now = secondsSinceStart();
+        if (!threaded_) {
+            for (int i = 0; i < kMaxCatchUpSteps && next_step_time_ <= now; ++i)
+                stepAndPublish();
+            next_step_time_ = std::max(next_step_time_, now - step_seconds_);
+        }
+        {
+            std::lock_guard<std::mutex> lock(swap_mutex_);
+            if (fresh_) {
+                // The old current becomes previous, the old previous goes back to the simulation.
+                int old_previous = previous_;
+                previous_ = current_;
+                current_ = middle_;
+                middle_ = old_previous;
+                fresh_ = false;
+            }
+        }
+
+        double span = times_[current_] - times_[previous_];
+        if (span <= 0.0)
+            return 1.0f;
+        double render_time = now - step_seconds_;
+        return static_cast<float>(std::min(1.0, std::max(0.0, (render_time - times_[previous_]) / span)));
+    }
+
+    const Snapshot& previous() const { return buffers_[previous_]; }
+    const Snapshot& current() const { return buffers_[current_]; }
+
+    /** @brief Bracket the caller's draw so render time shows up in stats(). */
+    void beginRender() { render_start_ = Clock::now(); }
+    void endRender() {
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - render_start_).count();
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.render_ms += (ms - stats_.render_ms) * kSmoothing;
+    }
+
+    PipelineStats stats() const {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        PipelineStats stats = stats_;
+        stats.threaded = threaded_;
+        return stats;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr double kSmoothing = 0.05;
+
+    double secondsSinceStart() const {
+        return std::chrono::duration<double>(Clock::now() - epoch_).count();
+    }
+
+    // Advances one fixed step, captures it into the back buffer and publishes it as the middle slot.
+    void stepAndPublish() {
+        Clock::time_point start = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(simulation_mutex_);
+            simulation_.step(static_cast<float>(step_seconds_));
+            simulation_.capture(buffers_[back_]);
+        }
+        simulation_time_ += step_seconds_;
+        next_step_time_ += step_seconds_;
+        times_[back_] = simulation_time_;
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        {
+            std::lock_guard<std::mutex> lock(swap_mutex_);
+            std::swap(back_, middle_);
+            if (fresh_)
+                ++dropped_;
+            fresh_ = true;
+        }
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.simulation_ms += (ms - stats_.simulation_ms) * kSmoothing;
+        stats_.dropped_snapshots = dropped_;
+        ++steps_this_second_;
+        double now = secondsSinceStart();
+        if (now - second_start_ >= 1.0) {
+            stats_.steps_per_second = steps_this_second_;
+            steps_this_second_ = 0;
+            second_start_ = now;
+        }
+    }
+
+#if HIRE_ME_HAS_THREADS
+    bool acquireThread() {
+        int running = simulationPipelineThreads().load();
+        while (running < kMaxThreads) {
+            if (simulationPipelineThreads().compare_exchange_weak(running, running + 1))
+                return true;
+        }
+        return false;
+    }
+
+    void releaseThread() { --simulationPipelineThreads(); }
+
+    void threadLoop() {
+        while (!stopping_) {
+            double now = secondsSinceStart();
+            if (next_step_time_ > now) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(next_step_time_ - now));
+                continue;
+            }
+            for (int i = 0; i < kMaxCatchUpSteps && next_step_time_ <= now && !stopping_; ++i)
+                stepAndPublish();
+            next_step_time_ = std::max(next_step_time_, now - step_seconds_);
+        }
+    }
+
+    std::thread thread_;
+    std::atomic<bool> stopping_{ false };
+#endif
+
+    Simulation simulation_;
+    std::mutex simulation_mutex_;
+
+    // Four buffers: one being written, one published, and the renderer's previous and current.
+    Snapshot buffers_[4];
+    double times_[4] = {};
+    int back_ = 0;
+    int middle_ = 1;
+    int previous_ = 2;
+    int current_ = 3;
+    bool fresh_ = false;
+    std::mutex swap_mutex_;
+
+    double step_seconds_;
+    double simulation_time_ = 0.0;
+    double next_step_time_ = 0.0;
+    Clock::time_point epoch_;
+    bool running_ = false;
+    bool threaded_ = false;
+
+    Clock::time_point render_start_;
+    mutable std::mutex stats_mutex_;
+    PipelineStats stats_;
+    int dropped_ = 0;
+    int steps_this_second_ = 0;
+    double second_start_ = 0.0;
+};
+
+/**
+ * @brief Draws a one-line PipelineStats readout in the top-left corner of a frame.
+ */
+inline void drawPipelineStats(visage::Canvas& canvas, const PipelineStats& stats, float width) {
+    char line[128];
+    std::snprintf(line, sizeof(line), "sim %.2f ms  render %.2f ms  %d steps/s  %d dropped%s",
+                  stats.simulation_ms, stats.render_ms, stats.steps_per_second, stats.dropped_snapshots,
+                  stats.threaded ? "" : "  (inline)");
+    const visage::Font& font = FontCache::shared().get(12);
+    canvas.setColor(0xffffffff);
+    canvas.text(line, font, visage::Font::Justification::kTopLeft, 4.0f, 4.0f, width - 8.0f, 16.0f);
+}
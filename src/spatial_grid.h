@@ -0,0 +1,127 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include <vector>
+#include <cmath>
+#include <algorithm> // For std::min/max
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform-grid bucketing of points for fixed-radius neighbour queries.
+ *
+ * build() counting-sorts the points into square cells of the query radius, so
+ * every pair closer than the radius is either in the same cell or in one of the
+ * eight around it. forEachPairWithin() visits each cell against itself and four
+ * of its neighbours, which covers every such pair exactly once, and compares
+ * squared distances so no sqrt is needed to reject a pair. Points are copied
+ * into cell order, keeping each inner loop on contiguous memory.
+ */
+class SpatialGrid {
+public:
+    /**
+     * @brief Buckets count points inside a width x height area.
+     * @param position Returns the visage::Point for an index in [0, count).
+     *        Points outside the area are clamped into the border cells.
+     */
+    template <typename PositionFunction>
+    void build(int count, float width, float height, float cell_size, PositionFunction position) {
+        cell_size_ = std::max(cell_size, 1.0f);
+        inv_cell_size_ = 1.0f / cell_size_;
+        columns_ = std::max(1, static_cast<int>(std::ceil(width * inv_cell_size_)));
+        rows_ = std::max(1, static_cast<int>(std::ceil(height * inv_cell_size_)));
+
+        int num_cells = columns_ * rows_;
+        cell_start_.assign(num_cells + 1, 0);
+        point_cells_.resize(count);
+        for (int i = 0; i < count; ++i) {
+            int cell = cellIndex(position(i));
+            point_cells_[i] = cell;
+            ++cell_start_[cell + 1];
+        }
+        for (int cell = 0; cell < num_cells; ++cell)
+            cell_start_[cell + 1] += cell_start_[cell];
+
+        xs_.resize(count);
+        ys_.resize(count);
+        ids_.resize(count);
+        scratch_fill_.assign(cell_start_.begin(), cell_start_.end() - 1);
+        for (int i = 0; i < count; ++i) {
+            int slot = scratch_fill_[point_cells_[i]]++;
+            visage::Point p = position(i);
+            xs_[slot] = p.x;
+            ys_[slot] = p.y;
+            ids_[slot] = i;
+        }
+    }
+
+    /**
+     * @brief Calls callback(i, j, distance_squared) once for every pair of points
+     *        closer than radius, with i and j the indices passed to build().
+     *        radius should be at most the cell size.
+     */
+    template <typename PairFunction>
+    void forEachPairWithin(float radius, PairFunction callback) const {
+        float radius_sq = radius * radius;
+        // Half of the neighbourhood, so each pair of cells is visited from one side only.
+        static constexpr int kNeighbourOffsets[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+
+        for (int row = 0; row < rows_; ++row) {
+            for (int column = 0; column < columns_; ++column) {
+                int cell = row * columns_ + column;
+                int start = cell_start_[cell];
+                int end = cell_start_[cell + 1];
+                if (start == end) continue;
+
+                for (int a = start; a < end; ++a) {
+                    for (int b = a + 1; b < end; ++b)
+                        testPair(a, b, radius_sq, callback);
+                }
+
+                for (const auto& offset : kNeighbourOffsets) {
+                    int neighbour_column = column + offset[0];
+                    int neighbour_row = row + offset[1];
+                    if (neighbour_column < 0 || neighbour_column >= columns_ || neighbour_row >= rows_)
+                        continue;
+
+                    int neighbour = neighbour_row * columns_ + neighbour_column;
+                    int neighbour_start = cell_start_[neighbour];
+                    int neighbour_end = cell_start_[neighbour + 1];
+                    for (int a = start; a < end; ++a) {
+                        for (int b = neighbour_start; b < neighbour_end; ++b)
+                            testPair(a, b, radius_sq, callback);
+                    }
+                }
+            }
+        }
+    }
+
+    int numCells() const { return columns_ * rows_; }
+    int numPoints() const { return static_cast<int>(ids_.size()); }
+
+private:
+    int cellIndex(visage::Point p) const {
+        int column = std::min(std::max(static_cast<int>(p.x * inv_cell_size_), 0), columns_ - 1);
+        int row = std::min(std::max(static_cast<int>(p.y * inv_cell_size_), 0), rows_ - 1);
+        return row * columns_ + column;
+    }
+
+    template <typename PairFunction>
+    void testPair(int a, int b, float radius_sq, PairFunction& callback) const {
+        float dx = xs_[a] - xs_[b];
+        float dy = ys_[a] - ys_[b];
+        float distance_sq = dx * dx + dy * dy;
+        if (distance_sq < radius_sq)
+            callback(ids_[a], ids_[b], distance_sq);
+    }
+
+    float cell_size_ = 1.0f;
+    float inv_cell_size_ = 1.0f;
+    int columns_ = 0;
+    int rows_ = 0;
+    std::vector<int> cell_start_;
+    std::vector<int> point_cells_;
+    std::vector<int> scratch_fill_;
+    std::vector<float> xs_;
+    std::vector<float> ys_;
+    std::vector<int> ids_;
+};
@@ -1,6 +1,9 @@
 #include "visage/windowing.h"
 #include "visage/graphics.h"
 #include "visage/ui.h"
+#include "stroke.h"
+#include "catmull_rom.h"
+#include "animation_scheduler.h"
 #include <vector>
 #include <cmath>
 
@@ -14,10 +17,19 @@ constexpr float TAU = 6.28318530718f;
  */
 class SplineDeformation : public visage::Frame {
 public:
+    static constexpr int kMaxSamplesPerSpan = 20; // Also the fixed count when the tolerance is 0
+    static constexpr float kDefaultSplineTolerance = 0.25f; // Pixels
+
     SplineDeformation() {
         setIgnoresMouseEvents(true, false);
     }
 
+    // Maximum distance in pixels between the drawn polyline and the true spline.
+    void setSplineTolerance(float tolerance) { spline_tolerance_ = tolerance; }
+    float splineTolerance() const { return spline_tolerance_; }
+    // Stroke segments emitted for the spline by the last draw.
+    int emittedSegments() const { return emitted_segments_; }
+
     void draw(visage::Canvas& canvas) override {
         visage::Point center(width() / 2.0f, height() / 2.0f);
         // Adjusted scale for fewer points to create a similar size
@@ -41,28 +53,9 @@ public:
 
                 // Draw the points in white
         drawPoints(canvas, 0xff000000, points, MAX_POINTS); // Changed to white (0xffffffff)
-
-        redraw();
     }
 
 private:
-    void drawThickLine(visage::Canvas& canvas, visage::Point p1, visage::Point p2, float thickness) const {
-        visage::Point delta = p2 - p1;
-        float length = sqrt(delta.x * delta.x + delta.y * delta.y);
-        if (length < 1e-6f) return;
-
-        visage::Point perp( -delta.y * (1.0f/length), delta.x * (1.0f/length) );
-        float half_thickness = thickness / 2.0f;
-
-        visage::Point v1 = p1 + perp * half_thickness;
-        visage::Point v2 = p2 + perp * half_thickness;
-        visage::Point v3 = p2 - perp * half_thickness;
-        visage::Point v4 = p1 - perp * half_thickness;
-
-        canvas.triangle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y);
-        canvas.triangle(v1.x, v1.y, v3.x, v3.y, v4.x, v4.y);
-    }
-
     /**
      * CORRECTED: This function now generates a closed loop by wrapping points.
      */
@@ -86,61 +79,34 @@ private:
         return p;
     }
 
-    visage::Point splineInterpolation(visage::Point p0, visage::Point p1, visage::Point p2, visage::Point p3, float t, float tension = 0.0f, float alpha = 0.5f) const {
-        auto distance = [](visage::Point a, visage::Point b) {
-            return sqrt(pow(a.x - b.x, 2) + pow(a.y - b.y, 2));
-        };
-        
-        float t01 = pow(distance(p0, p1), alpha);
-        float t12 = pow(distance(p1, p2), alpha);
-        float t23 = pow(distance(p2, p3), alpha);
-        
-        if (t01 < 1e-6f) t01 = 1.0f;
-        if (t12 < 1e-6f) t12 = 1.0f;
-        if (t23 < 1e-6f) t23 = 1.0f;
-        
-        float inv_t01 = 1.0f / t01;
-        float inv_t23 = 1.0f / t23;
-        float inv_t01_t12 = 1.0f / (t01 + t12);
-        float inv_t12_t23 = 1.0f / (t12 + t23);
-
-        visage::Point m1 = (p2 - p1 + (p1 - p0) * inv_t01 * t12 - (p2 - p0) * inv_t01_t12 * t12) * (1.0f - tension);
-        visage::Point m2 = (p2 - p1 + (p3 - p2) * inv_t23 * t12 - (p3 - p1) * inv_t12_t23 * t12) * (1.0f - tension);
-
-        visage::Point a = (p1 - p2) * 2.0f + m1 + m2;
-        visage::Point b = (p1 - p2) * -3.0f - m1 - m1 - m2;
-        visage::Point c = m1;
-        visage::Point d = p1;
-
-        return a * t * t * t + b * t * t + c * t + d;
-    }
-
-    void drawSpline(visage::Canvas& canvas, unsigned int drawColor, const std::vector<visage::Point>& p, float strokeWidth) const {
+    void drawSpline(visage::Canvas& canvas, unsigned int drawColor, const std::vector<visage::Point>& p, float strokeWidth) {
         if (p.size() < 4) return;
         canvas.setColor(drawColor);
 
         // CORRECTED: Loop through the original number of points to draw the full closed loop.
-        for (size_t i = 0; i < MAX_POINTS; ++i) {
-            visage::Point start_point = p[i+1];
-            for (int j = 1; j <= 20; ++j) {
-                float t = static_cast<float>(j) / 20.0f;
-                // The points p[i], p[i+1], p[i+2], p[i+3] now correctly wrap around
-                visage::Point end_point = splineInterpolation(p[i], p[i+1], p[i+2], p[i+3], t);
-                drawThickLine(canvas, start_point, end_point, strokeWidth);
-                start_point = end_point;
-            }
+        // The points p[i], p[i+1], p[i+2], p[i+3] now correctly wrap around, and the
+        // final sample lands back on p[1], so it is left to the closed stroke.
+        if (spline_tolerance_ > 0.0f) {
+            sampleClosedCatmullRomAdaptive(p.data(), MAX_POINTS, spline_tolerance_, kMaxSamplesPerSpan, spline_points_);
         }
+        else {
+            spline_points_.resize(MAX_POINTS * kMaxSamplesPerSpan);
+            sampleClosedCatmullRom(p.data(), MAX_POINTS, kMaxSamplesPerSpan, spline_points_.data());
+        }
+        emitted_segments_ = static_cast<int>(spline_points_.size());
+
+        stroke_.clear();
+        stroke_.addPolyline(spline_points_.data(), static_cast<int>(spline_points_.size()), true, strokeWidth);
+        stroke_.draw(canvas);
     }
     
     // Draw the black guide lines
-    void drawLines(visage::Canvas& canvas, unsigned int drawColor, const std::vector<visage::Point>& p, int pointCount) const {
+    void drawLines(visage::Canvas& canvas, unsigned int drawColor, const std::vector<visage::Point>& p, int pointCount) {
         canvas.setColor(drawColor);
-        for(int i = 0; i < pointCount; ++i) {
-            visage::Point p1 = p[i];
-            // Connect last point back to the first
-            visage::Point p2 = p[(i + 1) % pointCount];
-            drawThickLine(canvas, p1, p2, 1.0f);
-        }
+        // Connect last point back to the first
+        stroke_.clear();
+        stroke_.addPolyline(p.data(), pointCount, true, 1.0f);
+        stroke_.draw(canvas);
     }
     
     void drawPoints(visage::Canvas& canvas, unsigned int drawColor, const std::vector<visage::Point>& p, int pointCount) const {
@@ -149,4 +115,10 @@ private:
             canvas.circle(p[i].x - 4.0f, p[i].y - 4.0f, 8.0f); // Larger points
         }
     }
-};
+
+    StrokeMesh stroke_;
+    std::vector<visage::Point> spline_points_;
+    float spline_tolerance_ = kDefaultSplineTolerance;
+    int emitted_segments_ = 0;
+    ScheduledAnimation animation_{ this };
+};
\ No newline at end of file
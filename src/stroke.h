@@ -0,0 +1,431 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm> // For std::min
+
+enum class StrokeJoin {
+    kMiter, // Sharp corners, falling back to bevel past the miter limit.
+    kBevel, // Corners cut flat.
+    kRound  // Corners filled with a small fan.
+};
+
+/**
+ * @class StrokeMesh
+ * @brief Tessellates whole polylines into one indexed triangle mesh.
+ *
+ * Every point of a polyline contributes a shared left/right vertex pair, so
+ * neighbouring segments reuse each other's vertices instead of each segment
+ * emitting its own quad, and each segment's normal is computed once and shared
+ * by the joins at both of its ends. The mesh is submitted with a single draw()
+ * call, which hands visage one uninterrupted run of triangles.
+ */
+class StrokeMesh {
+public:
+    static constexpr float kDefaultMiterLimit = 4.0f;
+    static constexpr int kRoundJoinSteps = 4;
+    static constexpr int kHdrLevels = 32;
+
+    void clear() {
+        vertices_.clear();
+        anchors_.clear();
+        offsets_.clear();
+        sources_.clear();
+        indices_.clear();
+        segment_triangle_start_.clear();
+        num_points_ = 0;
+    }
+
+    void reserve(int num_points) {
+        vertices_.reserve(num_points * 4);
+        anchors_.reserve(num_points * 4);
+        offsets_.reserve(num_points * 4);
+        sources_.reserve(num_points * 4);
+        indices_.reserve(num_points * 12);
+    }
+
+    /**
+     * @brief Appends a polyline with a constant thickness.
+     */
+    void addPolyline(const visage::Point* points, int count, bool closed, float thickness,
+                     StrokeJoin join = StrokeJoin::kMiter, float miter_limit = kDefaultMiterLimit) {
+        addPolyline(points, count, closed, nullptr, thickness, join, miter_limit);
+    }
+
+    /**
+     * @brief Appends a polyline. If thicknesses is non-null it holds one
+     *        thickness per point, otherwise the constant thickness is used.
+     */
+    void addPolyline(const visage::Point* points, int count, bool closed, const float* thicknesses, float thickness,
+                     StrokeJoin join = StrokeJoin::kMiter, float miter_limit = kDefaultMiterLimit) {
+        if (count < 2) return;
+        if (count < 3) closed = false;
+
+        int n = count;
+        int num_segments = closed ? n : n - 1;
+        int first_point = num_points_;
+        num_points_ += n;
+
+        // One unit normal per segment. Zero-length segments borrow a neighbour's normal so
+        // segment indices always match the input points, even for duplicated samples.
+        scratch_normals_.resize(num_segments);
+        scratch_degenerate_.assign(num_segments, 0);
+        int first_valid = -1;
+        int last_valid = -1;
+        for (int i = 0; i < num_segments; ++i) {
+            visage::Point delta = points[(i + 1) % n] - points[i];
+            float length_sq = delta.x * delta.x + delta.y * delta.y;
+            if (length_sq < 1e-12f) {
+                scratch_degenerate_[i] = 1;
+                continue;
+            }
+            float inv_length = 1.0f / std::sqrt(length_sq);
+            scratch_normals_[i] = visage::Point(-delta.y * inv_length, delta.x * inv_length);
+            if (first_valid < 0) first_valid = i;
+            last_valid = i;
+        }
+        if (first_valid < 0) {
+            segment_triangle_start_.insert(segment_triangle_start_.end(), num_segments, numTriangles());
+            return;
+        }
+
+        int previous_valid = closed ? last_valid : first_valid;
+        for (int i = 0; i < num_segments; ++i) {
+            if (scratch_degenerate_[i])
+                scratch_normals_[i] = scratch_normals_[previous_valid];
+            else
+                previous_valid = i;
+        }
+
+        // For every point, the vertices that the outgoing and incoming segments attach to.
+        // Join fans are held back and emitted with their incoming segment below, so every
+        // triangle lies inside some segment's range.
+        scratch_joins_.resize(n);
+        scratch_fan_start_.assign(n + 1, 0);
+        scratch_fan_indices_.clear();
+        for (int i = 0; i < n; ++i) {
+            scratch_fan_start_[i] = static_cast<int>(scratch_fan_indices_.size());
+            bool has_in = closed || i > 0;
+            bool has_out = closed || i < n - 1;
+            int in_segment = (i + num_segments - 1) % num_segments;
+            int out_segment = i % num_segments;
+            float half_width = 0.5f * (thicknesses ? thicknesses[i] : thickness);
+            visage::Point p = points[i];
+            int source = first_point + i;
+
+            if (!has_in || !has_out) {
+                visage::Point normal = scratch_normals_[has_out ? out_segment : in_segment];
+                int left = addVertex(p, normal, source, half_width);
+                int right = addVertex(p, normal * -1.0f, source, half_width);
+                scratch_joins_[i] = { left, right, left, right };
+                continue;
+            }
+
+            visage::Point n_in = scratch_normals_[in_segment];
+            visage::Point n_out = scratch_normals_[out_segment];
+            visage::Point miter = n_in + n_out;
+            float miter_length_sq = miter.x * miter.x + miter.y * miter.y;
+            float cross = n_in.x * n_out.y - n_in.y * n_out.x;
+
+            // Straight (or fully folded back) joint: a plain shared pair is enough.
+            if (miter_length_sq < 1e-6f || std::abs(cross) < 1e-4f) {
+                int left = addVertex(p, n_out, source, half_width);
+                int right = addVertex(p, n_out * -1.0f, source, half_width);
+                scratch_joins_[i] = { left, right, left, right };
+                continue;
+            }
+
+            // Scale so the offset lands on both segment edges; 1 / cos(half angle).
+            float inv_miter_length = 1.0f / std::sqrt(miter_length_sq);
+            visage::Point miter_dir = miter * inv_miter_length;
+            float cos_half = miter_dir.x * n_out.x + miter_dir.y * n_out.y;
+            float miter_scale = 1.0f / std::max(cos_half, 1e-3f);
+
+            if (join == StrokeJoin::kMiter && miter_scale <= miter_limit) {
+                visage::Point offset = miter_dir * miter_scale;
+                int left = addVertex(p, offset, source, half_width);
+                int right = addVertex(p, offset * -1.0f, source, half_width);
+                scratch_joins_[i] = { left, right, left, right };
+                continue;
+            }
+
+            // Bevel or round: the inner side shares the (clamped) miter point, the outer
+            // side gets separate vertices for the incoming and outgoing segments.
+            visage::Point inner = miter_dir * std::min(miter_scale, miter_limit);
+            bool left_is_outer = cross < 0.0f;
+            if (left_is_outer) {
+                int right = addVertex(p, inner * -1.0f, source, half_width);
+                int left_in = addVertex(p, n_in, source, half_width);
+                int left_out = addVertex(p, n_out, source, half_width);
+                scratch_joins_[i] = { left_in, right, left_out, right };
+                addJoinFan(join, right, p, n_in, n_out, source, half_width, left_in, left_out);
+            }
+            else {
+                int left = addVertex(p, inner, source, half_width);
+                int right_in = addVertex(p, n_in * -1.0f, source, half_width);
+                int right_out = addVertex(p, n_out * -1.0f, source, half_width);
+                scratch_joins_[i] = { left, right_in, left, right_out };
+                addJoinFan(join, left, p, n_in * -1.0f, n_out * -1.0f, source, half_width, right_in, right_out);
+            }
+        }
+
+        scratch_fan_start_[n] = static_cast<int>(scratch_fan_indices_.size());
+
+        // Two triangles per segment, all sharing the per-point vertices above, then the
+        // fan at the segment's end point.
+        for (int i = 0; i < num_segments; ++i) {
+            segment_triangle_start_.push_back(numTriangles());
+            int end = (i + 1) % n;
+            if (!scratch_degenerate_[i]) {
+                const Join& a = scratch_joins_[i];
+                const Join& b = scratch_joins_[end];
+                addTriangle(a.left_out, b.left_in, b.right_in);
+                addTriangle(a.left_out, b.right_in, a.right_out);
+            }
+            indices_.insert(indices_.end(), scratch_fan_indices_.begin() + scratch_fan_start_[end],
+                            scratch_fan_indices_.begin() + scratch_fan_start_[end + 1]);
+        }
+    }
+
+    /**
+     * @brief Appends a single straight segment, for disconnected lines.
+     */
+    void addSegment(visage::Point p1, visage::Point p2, float thickness) {
+        visage::Point points[2] = { p1, p2 };
+        addPolyline(points, 2, false, thickness);
+    }
+
+    /**
+     * @brief Re-widths the mesh in place without re-tessellating it.
+     * @param thicknesses One thickness per point, numbered across every polyline
+     *        added since the last clear(). Join topology is independent of the
+     *        width, so this is a single multiply-add per vertex.
+     */
+    void setThicknesses(const float* thicknesses) {
+        for (size_t v = 0; v < vertices_.size(); ++v)
+            vertices_[v] = anchors_[v] + offsets_[v] * (0.5f * thicknesses[sources_[v]]);
+    }
+
+    /**
+     * @brief Submits the whole mesh in the canvas' current colour.
+     */
+    void draw(visage::Canvas& canvas) const {
+        for (size_t i = 0; i + 2 < indices_.size(); i += 3) {
+            const visage::Point& a = vertices_[indices_[i]];
+            const visage::Point& b = vertices_[indices_[i + 1]];
+            const visage::Point& c = vertices_[indices_[i + 2]];
+            canvas.triangle(a.x, a.y, b.x, b.y, c.x, c.y);
+        }
+    }
+
+    /**
+     * @brief Submits the mesh with a colour per segment. Segments are numbered
+     *        in the order they were added, one per input point pair, so callers
+     *        can index their own per-sample data. setColor is only called when
+     *        the returned colour differs from the previous one.
+     */
+    template <typename SegmentColorFunction>
+    void draw(visage::Canvas& canvas, SegmentColorFunction segment_color) const {
+        int num_segments = static_cast<int>(segment_triangle_start_.size());
+        bool first = true;
+        uint32_t last_key = 0;
+        for (int s = 0; s < num_segments; ++s) {
+            int start = segment_triangle_start_[s];
+            int end = s + 1 < num_segments ? segment_triangle_start_[s + 1] : numTriangles();
+            visage::Color color = segment_color(s);
+            uint32_t key = colorKey(color);
+            if (first || key != last_key) {
+                canvas.setColor(color);
+                last_key = key;
+                first = false;
+            }
+            for (int t = start; t < end; ++t) {
+                const visage::Point& a = vertices_[indices_[3 * t]];
+                const visage::Point& b = vertices_[indices_[3 * t + 1]];
+                const visage::Point& c = vertices_[indices_[3 * t + 2]];
+                canvas.triangle(a.x, a.y, b.x, b.y, c.x, c.y);
+            }
+        }
+    }
+
+    /**
+     * @brief Submits the mesh in one base colour with a per-point HDR multiplier.
+     *
+     * visage has no per-vertex colour for triangles, so each triangle takes the
+     * brightest HDR of its vertices, quantized to kHdrLevels steps between the
+     * dimmest and brightest point. Triangles are then bucketed by level and each
+     * bucket is one contiguous run behind a single setColor, so a stroke costs at
+     * most kHdrLevels colour changes however many segments it has.
+     */
+    void drawHdr(visage::Canvas& canvas, visage::Color base_color, const float* point_hdr) {
+        drawHdrTriangles(canvas, base_color, point_hdr, nullptr, numTriangles(), visage::Point(0.0f, 0.0f));
+    }
+
+    /**
+     * @brief drawHdr() for some of the segments only, shifted by -origin, e.g. for a
+     *        frame that covers one part of a larger stroke. The HDR levels still span
+     *        every point, so parts drawn separately use the same steps.
+     */
+    void drawHdr(visage::Canvas& canvas, visage::Color base_color, const float* point_hdr, const int* segments,
+                 int num_segments, visage::Point origin) {
+        scratch_triangles_.clear();
+        for (int i = 0; i < num_segments; ++i) {
+            int start = segment_triangle_start_[segments[i]];
+            int end = start + numSegmentTriangles(segments[i]);
+            for (int t = start; t < end; ++t)
+                scratch_triangles_.push_back(t);
+        }
+        drawHdrTriangles(canvas, base_color, point_hdr, scratch_triangles_.data(),
+                         static_cast<int>(scratch_triangles_.size()), origin);
+    }
+
+    int numPoints() const { return num_points_; }
+    int numVertices() const { return static_cast<int>(vertices_.size()); }
+    int numTriangles() const { return static_cast<int>(indices_.size() / 3); }
+    int numSegments() const { return static_cast<int>(segment_triangle_start_.size()); }
+    /** @brief Triangles drawn in a segment's colour: its quad plus the join fan at its end. */
+    int numSegmentTriangles(int segment) const {
+        int end = segment + 1 < numSegments() ? segment_triangle_start_[segment + 1] : numTriangles();
+        return end - segment_triangle_start_[segment];
+    }
+    const std::vector<visage::Point>& vertices() const { return vertices_; }
+    const std::vector<uint32_t>& indices() const { return indices_; }
+    /** @brief The point each vertex belongs to, numbered across every polyline. */
+    const std::vector<int>& sources() const { return sources_; }
+
+private:
+    struct Join {
+        int left_in;
+        int right_in;
+        int left_out;
+        int right_out;
+    };
+
+    static uint32_t colorKey(const visage::Color& color) {
+        return color.toARGB() ^ static_cast<uint32_t>(color.hdr() * 4096.0f);
+    }
+
+    // Every vertex is its source point pushed out along a unit-width offset.
+    int addVertex(visage::Point anchor, visage::Point offset, int source, float half_width) {
+        vertices_.push_back(anchor + offset * half_width);
+        anchors_.push_back(anchor);
+        offsets_.push_back(offset);
+        sources_.push_back(source);
+        return static_cast<int>(vertices_.size()) - 1;
+    }
+
+    void addTriangle(int a, int b, int c) {
+        indices_.push_back(a);
+        indices_.push_back(b);
+        indices_.push_back(c);
+    }
+
+    // triangles lists the triangles to draw, or is null for all of them in order.
+    void drawHdrTriangles(visage::Canvas& canvas, visage::Color base_color, const float* point_hdr,
+                          const int* triangles, int num_triangles, visage::Point origin) {
+        if (num_triangles == 0) return;
+        auto emit = [&](int t) {
+            visage::Point a = vertices_[indices_[3 * t]] - origin;
+            visage::Point b = vertices_[indices_[3 * t + 1]] - origin;
+            visage::Point c = vertices_[indices_[3 * t + 2]] - origin;
+            canvas.triangle(a.x, a.y, b.x, b.y, c.x, c.y);
+        };
+
+        float min_hdr = point_hdr[0];
+        float max_hdr = point_hdr[0];
+        for (int i = 1; i < num_points_; ++i) {
+            min_hdr = std::min(min_hdr, point_hdr[i]);
+            max_hdr = std::max(max_hdr, point_hdr[i]);
+        }
+
+        float range = max_hdr - min_hdr;
+        if (range < 1e-4f) {
+            base_color.setHdr(max_hdr);
+            canvas.setColor(base_color);
+            for (int i = 0; i < num_triangles; ++i)
+                emit(triangles ? triangles[i] : i);
+            return;
+        }
+
+        // Counting sort of the triangles by level.
+        float to_level = (kHdrLevels - 1) / range;
+        scratch_levels_.resize(num_triangles);
+        int level_count[kHdrLevels + 1] = {};
+        for (int i = 0; i < num_triangles; ++i) {
+            int t = triangles ? triangles[i] : i;
+            float hdr = std::max(point_hdr[sources_[indices_[3 * t]]],
+                                 std::max(point_hdr[sources_[indices_[3 * t + 1]]],
+                                          point_hdr[sources_[indices_[3 * t + 2]]]));
+            int level = static_cast<int>((hdr - min_hdr) * to_level + 0.5f);
+            scratch_levels_[i] = static_cast<uint8_t>(level);
+            ++level_count[level + 1];
+        }
+        for (int level = 0; level < kHdrLevels; ++level)
+            level_count[level + 1] += level_count[level];
+
+        scratch_order_.resize(num_triangles);
+        int fill[kHdrLevels];
+        std::copy(level_count, level_count + kHdrLevels, fill);
+        for (int i = 0; i < num_triangles; ++i)
+            scratch_order_[fill[scratch_levels_[i]]++] = triangles ? triangles[i] : i;
+
+        float level_step = range / (kHdrLevels - 1);
+        for (int level = 0; level < kHdrLevels; ++level) {
+            int start = level_count[level];
+            int end = level_count[level + 1];
+            if (start == end) continue;
+
+            base_color.setHdr(min_hdr + level * level_step);
+            canvas.setColor(base_color);
+            for (int i = start; i < end; ++i)
+                emit(scratch_order_[i]);
+        }
+    }
+
+    void addFanTriangle(int a, int b, int c) {
+        scratch_fan_indices_.push_back(a);
+        scratch_fan_indices_.push_back(b);
+        scratch_fan_indices_.push_back(c);
+    }
+
+    // Fills the wedge on the outer side of a joint, either flat or as a fan around the
+    // arc centred on p. Triangles pivot on the inner vertex so the wedge meets both quads.
+    // They go to the fan scratch, to be emitted with the incoming segment.
+    void addJoinFan(StrokeJoin join, int pivot, visage::Point p, visage::Point from, visage::Point to,
+                    int source, float half_width, int from_index, int to_index) {
+        if (join != StrokeJoin::kRound) {
+            addFanTriangle(pivot, from_index, to_index);
+            return;
+        }
+
+        float start_angle = std::atan2(from.y, from.x);
+        float sweep = std::atan2(from.x * to.y - from.y * to.x, from.x * to.x + from.y * to.y);
+        int previous = from_index;
+        for (int step = 1; step < kRoundJoinSteps; ++step) {
+            float angle = start_angle + sweep * step / kRoundJoinSteps;
+            int next = addVertex(p, visage::Point(std::cos(angle), std::sin(angle)), source, half_width);
+            addFanTriangle(pivot, previous, next);
+            previous = next;
+        }
+        addFanTriangle(pivot, previous, to_index);
+    }
+
+    std::vector<visage::Point> vertices_;
+    std::vector<visage::Point> anchors_;
+    std::vector<visage::Point> offsets_;
+    std::vector<int> sources_;
+    std::vector<uint32_t> indices_;
+    std::vector<int> segment_triangle_start_;
+    int num_points_ = 0;
+
+    std::vector<visage::Point> scratch_normals_;
+    std::vector<uint8_t> scratch_degenerate_;
+    std::vector<Join> scratch_joins_;
+    std::vector<int> scratch_fan_start_;
+    std::vector<uint32_t> scratch_fan_indices_;
+    std::vector<uint8_t> scratch_levels_;
+    std::vector<int> scratch_order_;
+    std::vector<int> scratch_triangles_;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "visage/graphics.h"
+#include <string>
+
+/**
+ * @class TextLayout
+ * @brief A string laid out once for a font and box, then drawn as-is.
+ *
+ * canvas.text() with a string hands the canvas a new string to measure and
+ * lay out on every call. A TextLayout keeps a visage::Text and only rebuilds
+ * it when the font, box size, string or justification actually change, so a
+ * page that redraws at the same size submits the already positioned glyphs.
+ * Moving the box does not relayout.
+ * Fonts should come from FontCache, whose references stay valid and can be
+ * compared by address.
+ */
+class TextLayout {
+public:
+    TextLayout() = default;
+    TextLayout(const std::string& text, visage::Font::Justification justification = visage::Font::Justification::kCenter)
+        : string_(text), justification_(justification) {}
+
+    void setText(const std::string& text) {
+        if (text == string_) return;
+        string_ = text;
+        invalidate();
+    }
+
+    void setJustification(visage::Font::Justification justification) {
+        if (justification == justification_) return;
+        justification_ = justification;
+        invalidate();
+    }
+
+    const std::string& text() const { return string_; }
+
+    void invalidate() { font_ = nullptr; }
+
+    void draw(visage::Canvas& canvas, const visage::Font& font, float x, float y, float width, float height) {
+        if (&font != font_ || width != width_ || height != height_) {
+            layout_ = visage::Text(string_, font, justification_);
+            font_ = &font;
+            width_ = width;
+            height_ = height;
+            ++num_layouts_;
+        }
+        canvas.text(&layout_, x, y, width, height);
+    }
+
+    /** @brief Times the text has been laid out, for comparing against draw counts. */
+    int numLayouts() const { return num_layouts_; }
+
+private:
+    std::string string_;
+    visage::Font::Justification justification_ = visage::Font::Justification::kCenter;
+    visage::Text layout_;
+    const visage::Font* font_ = nullptr;
+    float width_ = -1.0f;
+    float height_ = -1.0f;
+    int num_layouts_ = 0;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "visage/ui.h"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstdlib> // For std::abs
+#include <algorithm> // For std::min
+
+/**
+ * @brief The frames making up one view. The owner adds them to its frame tree
+ *        when the view is created and removes them before it is evicted.
+ */
+class ViewContent {
+public:
+    virtual ~ViewContent() = default;
+    virtual void setVisible(bool visible) = 0;
+};
+
+/**
+ * @class ViewManager
+ * @brief Builds views on first use and keeps only the ones near the current view.
+ *
+ * show() creates the requested view if needed and hides the others straight
+ * away. Neighbours within the prefetch distance are then built one per timer
+ * tick, hidden, so the next switch is instant without delaying the first
+ * frame. Views further than the keep distance are destroyed, so memory and
+ * per-frame cost depend on the distances rather than on how many views exist.
+ * Distances wrap around, matching the app's previous/next navigation.
+ */
+class ViewManager : public visage::EventTimer {
+public:
+    using Factory = std::function<std::unique_ptr<ViewContent>()>;
+
+    static constexpr int kDefaultPrefetchDistance = 1;
+    static constexpr int kDefaultKeepDistance = 1;
+    static constexpr int kPrefetchDelayMs = 50;
+
+    ~ViewManager() override { clear(); }
+
+    /** @brief Registers a view without building it; returns its index. */
+    int addView(Factory factory) {
+        views_.push_back({ std::move(factory), nullptr });
+        return static_cast<int>(views_.size()) - 1;
+    }
+
+    void setPrefetchDistance(int distance) { prefetch_distance_ = distance; }
+    /** @brief Views this far away stay built; never less than the prefetch distance. */
+    void setKeepDistance(int distance) { keep_distance_ = distance; }
+
+    /** @brief Called after a view is built, to add its frames. */
+    std::function<void(int, ViewContent&)>& onCreated() { return on_created_; }
+    /** @brief Called before a view is destroyed, to remove its frames. */
+    std::function<void(int, ViewContent&)>& onEvicted() { return on_evicted_; }
+
+    void show(int index) {
+        if (index < 0 || index >= numViews()) return;
+        current_ = index;
+        ViewContent& content = create(index);
+        for (int i = 0; i < numViews(); ++i) {
+            if (i != index && views_[i].content)
+                views_[i].content->setVisible(false);
+        }
+        content.setVisible(true);
+
+        for (int i = 0; i < numViews(); ++i) {
+            if (views_[i].content && distance(i, index) > std::max(keep_distance_, prefetch_distance_))
+                evict(i);
+        }
+        if (nextToPrefetch() >= 0)
+            startTimer(kPrefetchDelayMs);
+    }
+
+    /** @brief Destroys every view. */
+    void clear() {
+        stopTimer();
+        for (int i = 0; i < numViews(); ++i)
+            evict(i);
+        current_ = -1;
+    }
+
+    /** @brief Destroys every view and forgets their factories. */
+    void removeAllViews() {
+        clear();
+        views_.clear();
+    }
+
+    int current() const { return current_; }
+    int numViews() const { return static_cast<int>(views_.size()); }
+
+    int numLive() const {
+        int live = 0;
+        for (const Entry& entry : views_)
+            live += entry.content != nullptr;
+        return live;
+    }
+
+    /** @brief The view's content, or nullptr while it is not built. */
+    ViewContent* content(int index) const {
+        if (index < 0 || index >= numViews()) return nullptr;
+        return views_[index].content.get();
+    }
+
+    template <typename Function>
+    void forEachLive(Function function) {
+        for (int i = 0; i < numViews(); ++i) {
+            if (views_[i].content)
+                function(i, *views_[i].content);
+        }
+    }
+
+    void timerCallback() override {
+        int index = nextToPrefetch();
+        if (index >= 0)
+            create(index).setVisible(false);
+        if (nextToPrefetch() < 0)
+            stopTimer();
+    }
+
+private:
+    struct Entry {
+        Factory factory;
+        std::unique_ptr<ViewContent> content;
+    };
+
+    int distance(int a, int b) const {
+        int d = std::abs(a - b);
+        return std::min(d, numViews() - d);
+    }
+
+    // The closest unbuilt view within the prefetch distance, or -1.
+    int nextToPrefetch() const {
+        if (current_ < 0) return -1;
+        for (int d = 1; d <= prefetch_distance_; ++d) {
+            for (int index : { current_ + d, current_ - d }) {
+                index = (index % numViews() + numViews()) % numViews();
+                if (!views_[index].content)
+                    return index;
+            }
+        }
+        return -1;
+    }
+
+    ViewContent& create(int index) {
+        Entry& entry = views_[index];
+        if (!entry.content) {
+            entry.content = entry.factory();
+            if (on_created_)
+                on_created_(index, *entry.content);
+        }
+        return *entry.content;
+    }
+
+    void evict(int index) {
+        Entry& entry = views_[index];
+        if (!entry.content) return;
+        if (on_evicted_)
+            on_evicted_(index, *entry.content);
+        entry.content = nullptr;
+    }
+
+    std::vector<Entry> views_;
+    std::function<void(int, ViewContent&)> on_created_;
+    std::function<void(int, ViewContent&)> on_evicted_;
+    int current_ = -1;
+    int prefetch_distance_ = kDefaultPrefetchDistance;
+    int keep_distance_ = kDefaultKeepDistance;
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm> // For std::min/max
+#include <type_traits>
+
+// Native builds always have threads. The wasm build only does when it is compiled
+// with -pthread (SharedArrayBuffer); otherwise every job runs on the calling thread.
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define HIRE_ME_HAS_THREADS 1
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#else
+#define HIRE_ME_HAS_THREADS 0
+#endif
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of worker threads for data-parallel loops.
+ *
+ * parallelFor() splits an index range into one contiguous chunk per thread,
+ * runs the first chunk on the calling thread and returns only once every chunk
+ * is done, so it doubles as the barrier between simulating and drawing. Small
+ * ranges, and builds without threads, run inline with no synchronisation. It
+ * can be called from several threads; only one job uses the workers at a time.
+ */
+class WorkerPool {
+public:
+    static constexpr int kMaxThreads = 8;
+    static constexpr int kReservedThreads = 1;      // Left for SimulationPipeline threads (see its kMaxThreads)
+    static constexpr int kMinItemsPerThread = 4096; // Below this, waking a thread costs more than it saves
+
+    explicit WorkerPool(int num_threads = defaultNumThreads()) { setNumThreads(num_threads); }
+    ~WorkerPool() { stopWorkers(); }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /** @brief The pool shared by every effect in the app. */
+    static WorkerPool& shared() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief One thread per core, less the reserved ones, counting the caller's. The wasm
+     *        build preallocates one web worker per core (PTHREAD_POOL_SIZE), and a thread
+     *        started beyond those only gets its worker once the main thread yields, which
+     *        deadlocks a main thread that then waits on it. Keeping the pool's workers plus
+     *        the reserved threads below the core count means every thread has a worker ready.
+     */
+    static int defaultNumThreads() {
+#if HIRE_ME_HAS_THREADS
+        int cores = static_cast<int>(std::thread::hardware_concurrency());
+        return std::min(std::max(1, cores - kReservedThreads), kMaxThreads);
+#else
+        return 1;
+#endif
+    }
+
+    /** @brief Restarts the pool with num_threads threads, counting the caller's; at most defaultNumThreads(). */
+    void setNumThreads(int num_threads) {
+#if HIRE_ME_HAS_THREADS
+        stopWorkers();
+        num_threads_ = std::min(std::max(1, num_threads), defaultNumThreads());
+        stopping_ = false;
+        for (int i = 1; i < num_threads_; ++i)
+            workers_.emplace_back([this, i, generation = generation_] { workerLoop(i, generation); });
+#else
+        (void)num_threads;
+        num_threads_ = 1;
+#endif
+    }
+
+    int numThreads() const { return num_threads_; }
+
+    /**
+     * @brief Calls task(begin, end) over disjoint chunks covering [0, count) and
+     *        waits for all of them.
+     */
+    template <typename Task>
+    void parallelFor(int count, Task&& task) {
+        if (count <= 0) return;
+        int num_chunks = std::min(num_threads_, std::max(1, count / kMinItemsPerThread));
+        if (num_chunks <= 1) {
+            task(0, count);
+            return;
+        }
+
+#if HIRE_ME_HAS_THREADS
+        // One job at a time; a second thread arriving while the pool is busy runs its
+        // loop inline rather than waiting for the first to finish.
+        std::unique_lock<std::mutex> job_lock(job_mutex_, std::try_to_lock);
+        if (!job_lock.owns_lock()) {
+            task(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            using TaskType = typename std::remove_reference<Task>::type;
+            run_ = [](void* context, int begin, int end) { (*static_cast<TaskType*>(context))(begin, end); };
+            context_ = &task;
+            count_ = count;
+            num_chunks_ = num_chunks;
+            pending_ = num_chunks - 1;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        runChunk(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+#endif
+    }
+
+private:
+#if HIRE_ME_HAS_THREADS
+    void runChunk(int chunk) {
+        int begin = static_cast<int>(static_cast<long long>(count_) * chunk / num_chunks_);
+        int end = static_cast<int>(static_cast<long long>(count_) * (chunk + 1) / num_chunks_);
+        run_(context_, begin, end);
+    }
+
+    void workerLoop(int index, unsigned long long seen_generation) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+                if (stopping_) return;
+                seen_generation = generation_;
+                if (index >= num_chunks_) continue;
+            }
+
+            runChunk(index);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+                done_.notify_one();
+        }
+    }
+
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_)
+            worker.join();
+        workers_.clear();
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex job_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    void (*run_)(void*, int, int) = nullptr;
+    void* context_ = nullptr;
+    int count_ = 0;
+    int num_chunks_ = 0;
+    int pending_ = 0;
+    unsigned long long generation_ = 0;
+    bool stopping_ = false;
+#else
+    void stopWorkers() {}
+#endif
+    int num_threads_ = 1;
+};
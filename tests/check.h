@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdio>
+
+/**
+ * @brief Minimal assertions for the headless tests. A failed CHECK prints its
+ *        expression and line and is counted; main() returns checkFailures() so
+ *        ctest sees a non-zero exit.
+ */
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++checkFailures();                                                        \
+        }                                                                             \
+    } while (false)
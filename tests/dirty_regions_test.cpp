@@ -0,0 +1,87 @@
+// Redrawn area per frame: DirtyRegionTracker merges only where that costs no extra area and
+// counts overlaps once, and an animating AnimatedBorder redraws a thin ring, not the canvas.
+
+#include "check.h"
+#include "dirty_regions.h"
+#include "simple_frame.h"
+#include <cmath>
+
+namespace {
+
+bool near(double a, double b) { return std::abs(a - b) < 0.5; }
+
+// True if every point within reach of (x, y), sampled on a grid, lies inside one of the
+// border's edges.
+bool coveredByEdges(AnimatedBorder& border, float x, float y, float reach) {
+    for (int i = -4; i <= 4; ++i) {
+        for (int j = -4; j <= 4; ++j) {
+            float px = x + reach * i / 4.0f;
+            float py = y + reach * j / 4.0f;
+            bool inside = false;
+            for (int e = 0; e < AnimatedBorder::kNumEdges && !inside; ++e) {
+                visage::Bounds bounds = border.edge(e).bounds();
+                inside = px >= bounds.x() && px <= bounds.x() + bounds.width() && py >= bounds.y() &&
+                         py <= bounds.y() + bounds.height();
+            }
+            if (!inside) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    DirtyRegionTracker tracker;
+
+    // Heavily overlapping: one region, overlap counted once.
+    tracker.beginFrame();
+    tracker.add({ 0.0f, 0.0f, 10.0f, 10.0f }, 800.0f, 600.0f);
+    tracker.add({ 5.0f, 0.0f, 10.0f, 10.0f }, 800.0f, 600.0f);
+    tracker.endFrame();
+    CHECK(tracker.regions().size() == 1);
+    CHECK(near(tracker.pixels(), 150.0));
+
+    // Strips meeting at a corner stay apart, and their overlap still counts once.
+    tracker.beginFrame();
+    tracker.add({ 0.0f, 0.0f, 100.0f, 10.0f }, 800.0f, 600.0f);
+    tracker.add({ 0.0f, 0.0f, 10.0f, 100.0f }, 800.0f, 600.0f);
+    tracker.add({ 90.0f, 10.0f, 10.0f, 100.0f }, 800.0f, 600.0f);
+    tracker.endFrame();
+    CHECK(tracker.regions().size() == 3);
+    CHECK(near(tracker.pixels(), 2900.0));
+
+    // Clipped to the root.
+    tracker.beginFrame();
+    tracker.add({ -10.0f, 590.0f, 20.0f, 20.0f }, 800.0f, 600.0f);
+    tracker.endFrame();
+    CHECK(near(tracker.pixels(), 100.0));
+
+    // The border at 800x600: its four edges are what animates.
+    AnimationScheduler& scheduler = AnimationScheduler::shared();
+    visage::Frame root;
+    root.setBounds(0.0f, 0.0f, 800.0f, 600.0f);
+    AnimatedBorder border;
+    root.addChild(&border);
+    border.setBounds(0.0f, 0.0f, 800.0f, 600.0f);
+
+    scheduler.tick();
+    CHECK(scheduler.stats().ticked == AnimatedBorder::kNumEdges);
+    CHECK(scheduler.dirtyRegions().regions().size() == AnimatedBorder::kNumEdges);
+    // Bands of 2 * kEdgeReach around the 640x480 loop, 7.5% of the canvas.
+    double band = 2.0 * AnimatedBorder::kEdgeReach;
+    double ring = 2.0 * (640.0 + band) * band + 2.0 * (480.0 - band) * band;
+    CHECK(near(scheduler.stats().pixels, ring));
+    CHECK(scheduler.dirtyRegions().coverage() < 0.1);
+
+    // Every point of the line, at its boosted width, lies inside an edge.
+    float half_width = 0.5f * (AnimatedBorder::BASE_THICKNESS + AnimatedBorder::BOOSTED_THICKNESS_ADDITION);
+    for (float t = 0.0f; t <= 1.0f; t += 0.01f) {
+        CHECK(coveredByEdges(border, 80.0f + 640.0f * t, 60.0f, half_width));
+        CHECK(coveredByEdges(border, 80.0f + 640.0f * t, 540.0f, half_width));
+        CHECK(coveredByEdges(border, 80.0f, 60.0f + 480.0f * t, half_width));
+        CHECK(coveredByEdges(border, 720.0f, 60.0f + 480.0f * t, half_width));
+    }
+
+    return checkFailures();
+}
@@ -0,0 +1,96 @@
+// IdleMonitor driving the shared AnimationScheduler from a fake page visibility: hiding the
+// page suspends every animation and produces no frames, showing it resumes them as fresh
+// activity, and inactivity only caps the rate.
+
+#include "check.h"
+#include "idle_monitor.h"
+#include <vector>
+
+namespace {
+
+class FakeVisibility : public VisibilitySource {
+public:
+    bool pageVisible() const override { return visible; }
+    bool visible = true;
+};
+
+} // namespace
+
+int main() {
+    AnimationScheduler& scheduler = AnimationScheduler::shared();
+    FakeVisibility visibility;
+    IdleMonitor monitor(visibility, scheduler);
+    monitor.setInactivityTimeout(120.0);
+
+    std::vector<IdleState> changes;
+    monitor.onStateChanged() = [&](IdleState state) { changes.push_back(state); };
+
+    // One on-screen, uncapped animation, so every tick has something to run, pause and resume.
+    visage::Frame root;
+    root.setBounds(0, 0, 100, 100);
+    int pauses = 0;
+    int resumes = 0;
+    scheduler.add(&root, 0.0f);
+    scheduler.setCallbacks(&root, [&] { ++pauses; }, [&] { ++resumes; });
+
+    CHECK(monitor.update(0.0) == IdleState::kActive);
+    CHECK(changes.empty());
+    scheduler.tick();
+    CHECK(scheduler.stats().ticked == 1);
+    CHECK(resumes == 1);
+
+    // Hidden: the scheduler suspends, pauses the animation and produces no frames however
+    // often it is ticked or the monitor re-checks. The state hook is what pauses the main loop.
+    long long frames = scheduler.stats().frames;
+    long long redraws = scheduler.stats().redraws;
+    visibility.visible = false;
+    CHECK(monitor.update(1.0) == IdleState::kSuspended);
+    CHECK(!changes.empty() && changes.back() == IdleState::kSuspended);
+    CHECK(scheduler.suspended());
+    CHECK(scheduler.stats().suspended);
+    CHECK(pauses == 1);
+    for (int i = 0; i < 100; ++i) {
+        scheduler.tick();
+        if (i % 10 == 0)
+            CHECK(monitor.update(1.0 + i) == IdleState::kSuspended);
+    }
+    CHECK(scheduler.stats().ticked == 0);
+    CHECK(scheduler.stats().frames == frames);
+    CHECK(scheduler.stats().redraws == redraws);
+    CHECK(resumes == 1);
+
+    // Input while hidden doesn't wake anything.
+    monitor.noteActivity(1.5);
+    CHECK(scheduler.suspended());
+
+    // Visible again: ticking resumes and the animation restarts its time base.
+    visibility.visible = true;
+    CHECK(monitor.update(2.0) == IdleState::kActive);
+    CHECK(!scheduler.suspended());
+    CHECK(!scheduler.stats().suspended);
+    scheduler.tick();
+    CHECK(scheduler.stats().ticked == 1);
+    CHECK(resumes == 2);
+
+    // No input for the timeout since the page came back: low power caps the rate but keeps ticking.
+    CHECK(monitor.update(2.0 + 120.0) == IdleState::kLowPower);
+    CHECK(!scheduler.suspended());
+    monitor.noteActivity(200.0);
+    CHECK(monitor.state() == IdleState::kActive);
+
+    // Hidden for longer than the timeout: showing the page again counts as activity, so it
+    // comes back at full rate rather than straight into low power.
+    visibility.visible = false;
+    CHECK(monitor.update(210.0) == IdleState::kSuspended);
+    visibility.visible = true;
+    CHECK(monitor.update(210.0 + 3.0 * 120.0) == IdleState::kActive);
+    CHECK(monitor.update(210.0 + 4.0 * 120.0 - 1.0) == IdleState::kActive);
+    CHECK(monitor.update(210.0 + 4.0 * 120.0) == IdleState::kLowPower);
+
+    CHECK((changes == std::vector<IdleState>{ IdleState::kSuspended, IdleState::kActive, IdleState::kLowPower,
+                                              IdleState::kActive, IdleState::kSuspended, IdleState::kActive,
+                                              IdleState::kLowPower }));
+
+    scheduler.remove(&root);
+    return checkFailures();
+}
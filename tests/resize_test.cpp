@@ -0,0 +1,116 @@
+// MyApp::resizeTo without a page or renderer: each new size relays out the live frames in
+// place, moves the hit targets with them and rescales the page text, and the same size or a
+// non-positive one changes nothing.
+
+#include "check.h"
+#include "my_app.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+class FakeVisibility : public VisibilitySource {
+public:
+    bool pageVisible() const override { return true; }
+};
+
+bool near(const LayoutBox& a, const LayoutBox& b) {
+    return std::abs(a.x - b.x) < 0.01f && std::abs(a.y - b.y) < 0.01f && std::abs(a.width - b.width) < 0.01f &&
+           std::abs(a.height - b.height) < 0.01f;
+}
+
+bool hasBox(const ProportionalLayout& layout, const visage::Frame* frame, const LayoutBox& expected) {
+    const LayoutBox* box = layout.box(frame);
+    return box && near(*box, expected);
+}
+
+struct Size {
+    int width;
+    int height;
+};
+
+} // namespace
+
+int main() {
+    FakeVisibility visibility;
+    MyApp app(800, 600, visibility);
+    app.setNativeDimensions(800, 600);
+    app.showFallbackPage();
+
+    const ProportionalLayout& layout = app.proportionalLayout();
+    const ViewManager& views = app.views();
+    CHECK(views.numLive() == 1);
+    Slide* slide = static_cast<Slide*>(views.content(0));
+    CHECK(slide != nullptr);
+    SlidePage& page = static_cast<SlidePage&>(slide->page());
+    const visage::Frame* frames[] = { app.background(), app.borderFrame(), app.previousButton(),
+                                      app.nextButton(), &slide->page(), &slide->animation() };
+    int nodes = layout.stats().nodes;
+    // Every box the layout holds for the frames of the screen; missing ones as -1.
+    auto snapshot = [&] {
+        std::vector<LayoutBox> boxes;
+        for (const visage::Frame* frame : frames)
+            boxes.push_back(layout.box(frame) ? *layout.box(frame) : LayoutBox{ -1.0f, -1.0f, -1.0f, -1.0f });
+        return boxes;
+    };
+    std::vector<LayoutBox> initial = snapshot();
+
+    // Growing, shrinking, wide, tall and square, then back to where it started.
+    std::vector<Size> sizes = { { 1000, 500 }, { 1600, 900 }, { 640, 480 }, { 400, 800 },
+                                { 700, 700 }, { 1000, 500 }, { 800, 600 } };
+    std::vector<std::vector<LayoutBox>> seen;
+    for (Size size : sizes) {
+        long long updates = layout.stats().updates;
+        app.resizeTo(size.width, size.height);
+        float w = static_cast<float>(size.width);
+        float h = static_cast<float>(size.height);
+
+        // One relayout of every frame already there; nothing is built or dropped.
+        CHECK(layout.width() == w && layout.height() == h);
+        CHECK(layout.stats().updates == updates + 1);
+        CHECK(layout.stats().nodes == nodes);
+        CHECK(layout.stats().recomputed == nodes);
+        CHECK(views.numLive() == 1);
+        CHECK(views.content(0) == slide);
+
+        // Full-size frames, square buttons 10% of the width across, and the fallback
+        // slide's page and animation (inset 0.25).
+        float button = 0.1f * w;
+        CHECK(hasBox(layout, app.background(), { 0.0f, 0.0f, w, h }));
+        CHECK(hasBox(layout, app.borderFrame(), { 0.0f, 0.0f, w, h }));
+        CHECK(hasBox(layout, app.previousButton(), { 0.15f * w, 0.72f * h, button, button }));
+        CHECK(hasBox(layout, app.nextButton(), { 0.75f * w, 0.72f * h, button, button }));
+        CHECK(hasBox(layout, &slide->page(), { 0.125f * w, 0.125f * h, 0.75f * w, 0.75f * h }));
+        CHECK(hasBox(layout, &slide->animation(), { 0.25f * w, 0.4f * h, 0.5f * w, 0.5f * h }));
+
+        // Page text scales with the canvas.
+        CHECK(page.m_width == size.width && page.m_height == size.height);
+
+        // The hit index follows the new boxes.
+        CHECK(app.hitTest(0.2f * w, 0.72f * h + 0.5f * button) == app.previousButton());
+        CHECK(app.hitTest(0.8f * w, 0.72f * h + 0.5f * button) == app.nextButton());
+        CHECK(app.hitTest(0.5f * w, 0.5f * h) == nullptr);
+
+        // A size seen before gives exactly the boxes it gave then.
+        std::vector<LayoutBox> boxes = snapshot();
+        for (size_t i = 0; i < seen.size(); ++i) {
+            if (sizes[i].width == size.width && sizes[i].height == size.height)
+                CHECK(boxes == seen[i]);
+        }
+        seen.push_back(boxes);
+    }
+    CHECK(snapshot() == initial);
+
+    // Same size, and sizes a collapsed canvas reports, are ignored.
+    long long updates = layout.stats().updates;
+    app.resizeTo(800, 600);
+    app.resizeTo(0, 600);
+    app.resizeTo(800, 0);
+    app.resizeTo(-1, -1);
+    CHECK(layout.stats().updates == updates);
+    CHECK(layout.width() == 800.0f && layout.height() == 600.0f);
+    CHECK(snapshot() == initial);
+    CHECK(views.content(0) == slide);
+
+    return checkFailures();
+}
@@ -0,0 +1,59 @@
+// StrokeMesh segment ranges: every triangle, join fans included, is drawn in exactly one
+// segment's colour, and that segment is the one the triangle's points belong to.
+
+#include "check.h"
+#include "stroke.h"
+#include <vector>
+
+namespace {
+
+// Triangles of segment s may only use vertices of its two end points.
+void checkSegmentRanges(const StrokeMesh& mesh, const std::vector<int>& segment_points) {
+    int total = 0;
+    int start = 0;
+    for (int s = 0; s < mesh.numSegments(); ++s) {
+        int count = mesh.numSegmentTriangles(s);
+        CHECK(count >= 0);
+        int from = segment_points[2 * s];
+        int to = segment_points[2 * s + 1];
+        for (int t = start; t < start + count; ++t) {
+            for (int corner = 0; corner < 3; ++corner) {
+                int source = mesh.sources()[mesh.indices()[3 * t + corner]];
+                CHECK(source == from || source == to);
+            }
+        }
+        start += count;
+        total += count;
+    }
+    CHECK(total == mesh.numTriangles());
+}
+
+} // namespace
+
+int main() {
+    // A zigzag, so every interior point gets a join fan.
+    std::vector<visage::Point> zigzag;
+    for (int i = 0; i < 6; ++i)
+        zigzag.emplace_back(20.0f * i, i % 2 ? 20.0f : 0.0f);
+    std::vector<visage::Point> square = { { 0.0f, 0.0f }, { 50.0f, 0.0f }, { 50.0f, 50.0f }, { 0.0f, 50.0f } };
+
+    for (StrokeJoin join : { StrokeJoin::kBevel, StrokeJoin::kRound }) {
+        StrokeMesh mesh;
+        mesh.addPolyline(zigzag.data(), static_cast<int>(zigzag.size()), false, 4.0f, join);
+        mesh.addPolyline(square.data(), static_cast<int>(square.size()), true, 4.0f, join);
+
+        // Open zigzag: points 0-5, segments i -> i + 1. Closed square: points 6-9, wrapping.
+        std::vector<int> segment_points;
+        for (int i = 0; i < 5; ++i)
+            segment_points.insert(segment_points.end(), { i, i + 1 });
+        for (int i = 0; i < 4; ++i)
+            segment_points.insert(segment_points.end(), { 6 + i, 6 + (i + 1) % 4 });
+
+        CHECK(mesh.numSegments() == 9);
+        // More than two triangles per segment means the fans are in there too.
+        CHECK(mesh.numTriangles() > 2 * mesh.numSegments());
+        checkSegmentRanges(mesh, segment_points);
+    }
+
+    return checkFailures();
+}
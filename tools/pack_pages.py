@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Packs slide pages from JSON into the binary format read by src/page_data.h.
+
+Usage: pack_pages.py pages.json pages.bin
+
+All integers are little-endian.
+  header   "HMPG", u16 version, u16 page count, u32 offset per page plus one
+           end offset, each relative to the start of the file
+  page     u8 animation id, u8 run count, then per run:
+           u16 size and u16 y in thousandths of the reference height,
+           u16 byte length, UTF-8 text
+"""
+
+import json
+import struct
+import sys
+
+MAGIC = b"HMPG"
+VERSION = 1
+ANIMATIONS = ["circle", "shards", "pulsar", "spline"]
+MAX_U16 = 0xFFFF
+
+
+def permille(value, what):
+    result = int(round(value * 1000))
+    if not 0 <= result <= MAX_U16:
+        raise ValueError(f"{what} {value} is out of range")
+    return result
+
+
+def pack_page(page, index):
+    animation = page.get("animation", ANIMATIONS[0])
+    if animation not in ANIMATIONS:
+        raise ValueError(f"page {index}: unknown animation '{animation}', expected one of {ANIMATIONS}")
+    runs = page.get("text", [])
+    if len(runs) > 0xFF:
+        raise ValueError(f"page {index}: too many text runs ({len(runs)})")
+
+    data = bytearray(struct.pack("<BB", ANIMATIONS.index(animation), len(runs)))
+    for run in runs:
+        text = run["text"].encode("utf-8")
+        if len(text) > MAX_U16:
+            raise ValueError(f"page {index}: text run is too long")
+        data += struct.pack("<HHH", permille(run["size"], "size"), permille(run["y"], "y"), len(text))
+        data += text
+    return bytes(data)
+
+
+def pack(pages):
+    if len(pages) > MAX_U16:
+        raise ValueError(f"too many pages ({len(pages)})")
+    bodies = [pack_page(page, index) for index, page in enumerate(pages)]
+    header_size = len(MAGIC) + 4 + 4 * (len(bodies) + 1)
+
+    offsets = [header_size]
+    for body in bodies:
+        offsets.append(offsets[-1] + len(body))
+
+    header = MAGIC + struct.pack("<HH", VERSION, len(bodies)) + struct.pack(f"<{len(offsets)}I", *offsets)
+    return header + b"".join(bodies)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    with open(sys.argv[1], encoding="utf-8") as source:
+        pages = json.load(source)["pages"]
+    with open(sys.argv[2], "wb") as output:
+        output.write(pack(pages))
+
+
+if __name__ == "__main__":
+    main()